@@ -0,0 +1,92 @@
+#include "headers/truc.h"
+#include "headers/gameengine.h"
+#include "headers/rules.h"
+#include "headers/simulation.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// One S17 hand hitting below 17 from a fresh deck, written out by hand with
+// no policies: the baseline the engine must keep up with. Nothing plays
+// through it but the benchmark.
+static char handWritten(Deck &deck, Hand &player, Hand &dealer){
+    player.clearCards();
+    dealer.clearCards();
+    player.addCard(deck.deal());
+    dealer.addCard(deck.deal());
+    player.addCard(deck.deal());
+    dealer.addCard(deck.deal());
+    char result = Rules::checkEnd(dealer.getSum(), player.getSum());
+    if(result!='f'){
+        return result;
+    }
+    while(player.getSum()<Rules::DEALER_STANDS){
+        player.addCard(deck.deal());
+        result = Rules::checkEnd(dealer.getSum(), player.getSum());
+        if(result!='f'){
+            return result;
+        }
+    }
+    if(Rules::dealerPlays(dealer.getSum(), player.getSum())){
+        while(Rules::dealerDraws(dealer.getSum())){
+            dealer.addCard(deck.deal());
+            result = Rules::checkEnd(dealer.getSum(), player.getSum());
+            if(result!='f'){
+                return result;
+            }
+        }
+    }
+    return Rules::compareSum(dealer.getSum(), player.getSum());
+}
+
+// Times `hands` blackjack hands with the hand-written loop, GameEngine
+// variants and Simulation (the engine over its chunks), and checks they agree
+int bench(long long hands, uint64_t seed){
+    std::cout<<std::fixed<<std::setprecision(1);
+    Deck deck;
+    Hand player, dealer;
+    SimulationResult reference, s17, h17;
+    deck.seed(seed, 0);
+    auto start = std::chrono::steady_clock::now();
+    for(long long i=0;i<hands;i++){
+        deck.initializeDeck();
+        deck.setHand(i);
+        reference.add(handWritten(deck, player, dealer));
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout<<"Hand-written loop:               "<<(secs>0 ? hands/secs/1e6 : 0.0)<<" M hands/s\n";
+    HitBelow policy = {Rules::DEALER_STANDS};
+    GameEngine<ClassicBlackjack> engine(seed);
+    start = std::chrono::steady_clock::now();
+    for(long long i=0;i<hands;i++){
+        s17.add(engine.playRound(policy));
+    }
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout<<"GameEngine<ClassicBlackjack>:    "<<(secs>0 ? hands/secs/1e6 : 0.0)<<" M hands/s\n";
+    Simulation simulation(hands, 1, seed);
+    start = std::chrono::steady_clock::now();
+    SimulationResult simulated = simulation.run();
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout<<"Simulation::run():               "<<(secs>0 ? hands/secs/1e6 : 0.0)<<" M hands/s\n";
+    GameEngine<ClassicBlackjackH17> engineH17(seed);
+    start = std::chrono::steady_clock::now();
+    for(long long i=0;i<hands;i++){
+        h17.add(engineH17.playRound(policy));
+    }
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout<<"GameEngine<ClassicBlackjackH17>: "<<(secs>0 ? hands/secs/1e6 : 0.0)<<" M hands/s (EV "
+             <<std::setprecision(4)<<h17.getEV()<<" vs "<<s17.getEV()<<" with S17)\n";
+    TrucBaseline baseline;
+    GameEngine<TrucHeadsUp> truc(seed);
+    long long trucHands = hands/10, points = 0;
+    start = std::chrono::steady_clock::now();
+    for(long long i=0;i<trucHands;i++){
+        points += truc.playRound(baseline);
+    }
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout<<std::setprecision(1)<<"GameEngine<TrucHeadsUp>:         "<<(secs>0 ? trucHands/secs/1e6 : 0.0)<<" M hands/s\n";
+    bool same = reference.wins==s17.wins && reference.loses==s17.loses && reference.pushes==s17.pushes &&
+                reference.wins==simulated.wins && reference.loses==simulated.loses && reference.pushes==simulated.pushes;
+    std::cout<<"Engine, simulation and hand-written results "<<(same ? "match" : "DIFFER")<<"\n";
+    return same ? 0 : 1;
+}
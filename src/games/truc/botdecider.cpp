@@ -0,0 +1,41 @@
+#include "headers/botdecider.h"
+#include "headers/rules.h"
+
+//////////////* Constructor *////
+
+BotDecider::BotDecider(const StrategyTable *st, TrucBot *bot, long long n){
+    strategy = st;
+    truc = bot;
+    rounds = n;
+    played = 0;
+}
+
+//////////////* Blackjack *////
+
+// Raises $5 at a time up to the table's bet for the cards left
+int BotDecider::chooseBet(int cash, int bet, int cardsLeft){
+    int units = strategy!=NULL ? strategy->decide(StrategyTable::betKey(cardsLeft)) : -1;
+    int target = 5*(units>0 ? units : 1);
+    return bet<target && cash>=5 ? BET_RAISE : BET_DONE;
+}
+
+bool BotDecider::chooseHit(const Hand &player, Card up){
+    if(strategy==NULL){
+        return Rules::dealerDraws(player.getSum());
+    }
+    int v = up.getValue();
+    return strategy->decide(StrategyTable::playKey(player.getSum(), player.isSoft(), v==11 ? 1 : v))=='H';
+}
+
+bool BotDecider::keepPlaying(){
+    return ++played<rounds;
+}
+
+//////////////* Truc *////
+
+uint8_t BotDecider::chooseTrucMove(const TrucState &s){
+    if(truc!=NULL){
+        return truc->decide(s);
+    }
+    return s.phase==TrucState::RESPOND ? (uint8_t)TrucState::ACCEPT : (uint8_t)s.heuristicCard();
+}
@@ -0,0 +1,31 @@
+#include "headers/truc.h"
+#include "headers/truccfr.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Trains the bidding strategy in `path` for `iterations` more iterations,
+// resuming from the file if it exists and saving a checkpoint every chunk
+int trainCfr(const std::string &path, long long iterations, int threads, uint64_t seed){
+    const long long CHUNK = 200000;
+    TrucCfr cfr;
+    if(cfr.load(path)){
+        std::cout<<"Resuming "<<path<<" after "<<cfr.getIterations()<<" iterations\n";
+    }
+    auto start = std::chrono::steady_clock::now();
+    long long done = 0;
+    while(done<iterations){
+        long long n = iterations-done<CHUNK ? iterations-done : CHUNK;
+        cfr.train(n, threads, seed, 1000);
+        done += n;
+        if(!cfr.save(path)){
+            std::cerr<<"Could not write "<<path<<"\n";
+            return 1;
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+        std::cout<<std::fixed<<std::setprecision(1)<<"Iterations: "<<cfr.getIterations()<<" ("
+                 <<(secs>0 ? done/secs/1000 : 0.0)<<" k/s), checkpoint saved\n";
+    }
+    std::cout<<cfr.getInfosets()<<" information sets written to "<<path<<"\n";
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "headers/client.h"
+#include "headers/banca.h"
+#include "headers/color.h"
+#include "headers/input.h"
+#include "headers/print.h"
+#include "headers/rules.h"
+#include "headers/server.h"
+#include <unistd.h>
+
+//////////////* Constructor and Destructor *////
+
+Client::Client(){
+    fd = -1;
+    view.phase = Table::BANKRUPT;
+}
+
+Client::~Client(){
+    if(fd>=0){
+        close(fd);
+    }
+}
+
+bool Client::connect(const std::string &address){
+    fd = Server::connect(address);
+    return fd>=0;
+}
+
+//////////////* Messages *////
+
+// Sends one frame and waits for the state it's answered with
+bool Client::send(uint8_t type, const std::string &payload){
+    std::string out;
+    Protocol::frame(out, type, payload.data(), payload.size());
+    if(write(fd, out.data(), out.size())!=(ssize_t)out.size()){
+        return false;
+    }
+    if(type==Protocol::LEAVE){
+        return true;
+    }
+    int size;
+    while((size = Protocol::frameSize(in, 0))==0){
+        char buf[512];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if(n<=0){
+            return false;
+        }
+        in.append(buf, n);
+    }
+    if(size<0){
+        return false;
+    }
+    const uint8_t *f = (const uint8_t*)in.data();
+    bool ok = f[1]==Protocol::STATE && Protocol::readState(f+2, size-2, view);
+    in.erase(0, size);
+    return ok;
+}
+
+//////////////* Playing *////
+
+void Client::play(){
+    screen.begin()<<yellow<<Print::title_blackjack()<<def<<"\n"<<"Enter player name: ";
+    screen.present();
+    name = Input::session().word();
+    if(name.size()>Protocol::MAX_NAME){
+        name.resize(Protocol::MAX_NAME);
+    }
+    screen.invalidate();
+    if(!send(Protocol::JOIN, name)){
+        return;
+    }
+    while(true){
+        draw();
+        int c = toupper(Input::session().key());
+        uint8_t type = 0;
+        if(c=='Q'){
+            send(Protocol::LEAVE);
+            return;
+        }
+        switch(view.phase){
+            case Table::BETTING: type = c=='W' ? Protocol::RAISE : c=='S' ? Protocol::LOWER : c=='R' ? Protocol::DEAL : 0; break;
+            case Table::PLAYING: type = c=='H' ? Protocol::HIT : c=='S' ? Protocol::STAND : 0; break;
+            case Table::OVER: type = Protocol::NEXT; break;
+            default: send(Protocol::LEAVE);
+                     return;
+        }
+        if(type!=0 && !send(type)){
+            screen.out()<<lightRed<<"\nConnection lost.\n"<<def;
+            screen.present();
+            return;
+        }
+    }
+}
+
+//////////////* Printing Stuff *////
+
+void Client::draw(){
+    std::ostream &out = screen.begin();
+    out<<yellow<<Print::title_blackjack()<<def<<"\n";
+    out<<lightGreen<<"\t\tCash: "<<view.cash<<lightMagenta<<" \tBet: "<<view.bet<<lightBlue<<" \tName: "<<name<<def<<"\n\n\n";
+    Banca dealer;
+    Human player;
+    for(int i=0;i<view.dealer.getSize();i++){
+        dealer.addCard(view.dealer.getCard(i));
+    }
+    for(int i=0;i<view.player.getSize();i++){
+        player.addCard(view.player.getCard(i));
+    }
+    switch(view.phase){
+        case Table::BETTING:
+            out<<"Place your bet!\t\t $"<<green<<view.bet<<def<<"\n[W = Raise Bet | S = Decrease Bet | R = Done | Q = Leave]\n";
+            break;
+        case Table::PLAYING:
+            out<<lightRed<<Print::dealer_border()<<def;
+            dealer.printFirstCard(out);
+            out<<lightCyan<<Print::player_border()<<def;
+            player.printCards(out);
+            out<<lightGreen<<"\nSum: "<<lightRed<<player.getSum()<<def<<"\n";
+            out<<lightYellow<<"\n\nH : Hit | S : Stand | Q : Leave\n"<<def;
+            break;
+        case Table::OVER:
+            if(dealer.getSum()>Rules::BLACKJACK || player.getSum()>Rules::BLACKJACK){
+                out<<red<<Print::bust()<<def;
+            }
+            else if(dealer.getSum()==Rules::BLACKJACK || player.getSum()==Rules::BLACKJACK){
+                out<<lightGreen<<Print::blackjack()<<def;
+            }
+            else{
+                switch(view.result){
+                    case 'p': out<<lightYellow<<Print::you_win()<<def; break;
+                    case 'd': out<<lightRed<<Print::dealer_wins()<<def; break;
+                    default: out<<lightMagenta<<Print::draw()<<def;
+                }
+            }
+            out<<"\n    [Dealer : "<<dealer.getSum()<<" | "<<name<<" : "<<player.getSum()<<"]\n";
+            out<<lightRed<<Print::dealer_border()<<def;
+            dealer.printCards(out);
+            out<<lightCyan<<Print::player_border()<<def;
+            player.printCards(out);
+            out<<yellow<<"\nYour wins: "<<view.wins<<lightRed<<"\nYour loses: "<<view.loses<<def<<"\n";
+            out<<"\n[Any key = Next round | Q = Leave]\n";
+            break;
+        default:
+            out<<lightRed<<"\nBankrupt! Game over.\n"<<def<<"\n\t(Press any key to leave)\n";
+    }
+    screen.present();
+}
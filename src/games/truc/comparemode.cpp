@@ -0,0 +1,64 @@
+#include "headers/truc.h"
+#include "headers/simulation.h"
+#include "headers/solver.h"
+#include "headers/strategytable.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Plays the same shuffles with two blackjack strategies, "hit:N" (hits
+// below N), "chart:FILE" or "basic" (the infinite-deck chart, solved here),
+// and prints the paired difference
+int compare(long long hands, const std::vector<std::string> &specs, bool antithetic, int threads, uint64_t seed, const StoppingRule &rule){
+    StrategyTable charts[2];
+    ChartOrHitBelow players[2];
+    for(int i=0;i<2;i++){
+        const std::string &spec = specs[i];
+        players[i].chart = NULL;
+        players[i].total = 0;
+        if(spec.compare(0, 4, "hit:")==0){
+            players[i].total = atoi(spec.c_str()+4);
+        }
+        else if(spec.compare(0, 6, "chart:")==0 && charts[i].load(spec.substr(6))){
+            players[i].chart = &charts[i];
+        }
+        else if(spec=="basic"){
+            Solver solver;
+            solver.solve(1);
+            charts[i].compile(chartEntries(solver));
+            players[i].chart = &charts[i];
+        }
+        else{
+            std::cerr<<"Could not use "<<spec<<" (hit:N, chart:FILE or basic)\n";
+            return 1;
+        }
+    }
+    Simulation sim(hands, threads, seed);
+    ProgressLine line("Hands", rule);
+    if(rule.isActive()){
+        sim.setStopping(&rule, [&line](const Welford &w){ line.show(w); });
+    }
+    auto start = std::chrono::steady_clock::now();
+    PairedResult r = sim.compare(players[0], players[1], antithetic);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    line.end(r.getUnits(PairedResult::DIFF));
+    long long played = r.samples*r.handsPerSample;
+    std::cout<<std::fixed<<std::setprecision(4);
+    std::cout<<"Hands:   "<<played<<" each on the same shuffles"<<(antithetic ? ", half of them mirrored" : "")
+             <<" ("<<threads<<" threads, seed "<<seed<<")\n";
+    if(antithetic && hands%2==1 && played>hands){
+        std::cout<<"         ("<<hands<<" rounded up to whole mirrored pairs)\n";
+    }
+    std::cout<<"A:       "<<r.getMean(PairedResult::A)<<" +/- "<<1.96*r.getStdError(PairedResult::A)<<" per unit bet ("<<specs[0]<<")\n";
+    std::cout<<"B:       "<<r.getMean(PairedResult::B)<<" +/- "<<1.96*r.getStdError(PairedResult::B)<<" per unit bet ("<<specs[1]<<")\n";
+    std::cout<<"A-B:     "<<r.getMean(PairedResult::DIFF)<<" +/- "<<1.96*r.getStdError(PairedResult::DIFF)<<" per unit bet\n";
+    std::cout<<std::setprecision(1);
+    std::cout<<"Gain:    independent runs would need "<<r.getGain()<<"x the hands for this interval\n";
+    std::cout<<std::setprecision(2);
+    std::cout<<"Time:    "<<secs<<" s ("<<(secs>0 ? 2*played/secs/1e6*60 : 0.0)<<" M hands/min)\n";
+    if(rule.isActive()){
+        printVerdict(sim.getVerdict(), rule, r.getUnits(PairedResult::DIFF), "A-B");
+    }
+    return 0;
+}
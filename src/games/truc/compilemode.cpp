@@ -0,0 +1,39 @@
+#include "headers/truc.h"
+#include "headers/strategytable.h"
+#include <fstream>
+#include <iostream>
+
+// Compiles `entries` and writes the table to `path`
+int writeStrategy(const std::vector<StrategyTable::Entry> &entries, const std::string &path){
+    StrategyTable table;
+    if(!table.compile(entries)){
+        std::cerr<<"Could not compile the strategy (duplicate rules?)\n";
+        return 1;
+    }
+    if(!table.save(path)){
+        std::cerr<<"Could not write "<<path<<"\n";
+        return 1;
+    }
+    std::cout<<"Strategy written to "<<path<<" ("<<table.getSize()<<" keys, "<<table.getBuckets()<<" buckets)\n";
+    return 0;
+}
+
+// Compiles a text strategy description
+int compileStrategy(const std::string &source, const std::string &path){
+    std::ifstream f1(source);
+    if(f1.fail()){
+        std::cerr<<"Could not open "<<source<<"\n";
+        return 1;
+    }
+    std::vector<StrategyTable::Entry> entries;
+    std::string line;
+    int lineNumber = 0;
+    while(std::getline(f1, line)){
+        lineNumber++;
+        if(!StrategyTable::parse(line, entries)){
+            std::cerr<<source<<":"<<lineNumber<<": invalid rule\n";
+            return 1;
+        }
+    }
+    return writeStrategy(entries, path);
+}
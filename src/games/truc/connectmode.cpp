@@ -0,0 +1,29 @@
+#include "headers/truc.h"
+#include "headers/client.h"
+#include "headers/server.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Sits at a server table, or loads it with `clients` bot connections
+int joinServer(const std::string &address, int clients, long long rounds){
+    if(clients>0){
+        auto start = std::chrono::steady_clock::now();
+        long long replies = Server::bench(address, clients, rounds);
+        if(replies<0){
+            std::cerr<<"Could not connect to "<<address<<"\n";
+            return 1;
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+        std::cout<<clients<<" clients, "<<replies<<" replies in "<<std::fixed<<std::setprecision(2)<<secs<<" s ("
+                 <<(secs>0 ? replies/secs/1000 : 0.0)<<" k requests/s)\n";
+        return 0;
+    }
+    Client client;
+    if(!client.connect(address)){
+        std::cerr<<"Could not connect to "<<address<<"\n";
+        return 1;
+    }
+    client.play();
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "headers/truc.h"
+#include "headers/doubledummy.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// Solves every deal of a hand-history file, one "team" line per deal
+int solveDeals(const std::string &path, int threads){
+    std::ifstream f1(path);
+    if(f1.fail()){
+        std::cerr<<"Could not open "<<path<<"\n";
+        return 1;
+    }
+    std::vector<TrucState> deals;
+    std::string line;
+    int lineNumber = 0;
+    while(std::getline(f1, line)){
+        lineNumber++;
+        if(line.empty() || line[0]=='#'){
+            continue;
+        }
+        TrucState s;
+        std::string error;
+        if(!DoubleDummy::parseDeal(line, s, error)){
+            std::cerr<<path<<":"<<lineNumber<<": invalid deal, "<<error<<"\n";
+            return 1;
+        }
+        deals.push_back(s);
+    }
+    std::vector<int8_t> winners;
+    auto start = std::chrono::steady_clock::now();
+    DoubleDummy::solveBatch(deals, winners, threads);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    long long wins[2] = {0, 0};
+    for(size_t i=0;i<winners.size();i++){
+        std::cout<<(int)winners[i]<<"\n";
+        wins[winners[i]]++;
+    }
+    std::cerr<<deals.size()<<" deals solved in "<<std::fixed<<std::setprecision(2)<<secs<<" s (team 0: "
+             <<wins[0]<<", team 1: "<<wins[1]<<")\n";
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include "headers/dealerodds.h"
+#include "headers/rules.h"
+
+//////////////* Composition *////
+
+Composition::Composition(){
+    for(int v=0;v<VALUES;v++){
+        count[v] = 0;
+    }
+    total = 0;
+}
+
+// Counts the cards left in a deck
+Composition Composition::fromDeck(Deck &d){
+    Composition c;
+    Card cards[Deck::MAX_CARDS];
+    int n = d.getCards(cards);
+    for(int i=0;i<n;i++){
+        c.add(valueIndex(cards[i]));
+    }
+    return c;
+}
+
+// Full shoe of n French decks (1 to MAX_DECKS)
+Composition Composition::decks(int n){
+    Composition c;
+    for(int v=0;v<VALUES;v++){
+        c.count[v] = (v==9 ? 16 : 4)*n;
+        c.total += c.count[v];
+    }
+    return c;
+}
+
+int Composition::valueIndex(Card c){
+    return c.getNumber()>=10 ? 9 : c.getNumber()-1;
+}
+
+void Composition::add(int v){
+    count[v]++;
+    total++;
+}
+
+void Composition::remove(int v){
+    count[v]--;
+    total--;
+}
+
+// Exact packing: 6 bits for aces to nines, 8 bits for tens (up to 15 decks)
+uint64_t Composition::getKey() const{
+    uint64_t k = count[9];
+    for(int v=0;v<9;v++){
+        k = (k<<6)|count[v];
+    }
+    return k;
+}
+
+//////////////* Dealer Outcome *////
+
+DealerOutcome::DealerOutcome(){
+    for(int i=0;i<6;i++){
+        p[i] = 0.0;
+    }
+}
+
+// Probability of ending on `sum` (any sum over 21 means bust)
+double DealerOutcome::get(int sum) const{
+    if(sum>Rules::BLACKJACK) return p[BUST];
+    if(sum<Rules::DEALER_STANDS) return 0.0;
+    return p[sum-Rules::DEALER_STANDS];
+}
+
+//////////////* Recursion *////
+
+// Distribution from a dealer holding `hard` (aces as 1) and the given shoe.
+// Plain recursion: the dealer draws at most a few cards, so recomputing the
+// short subtrees is cheaper than hashing every intermediate composition
+DealerOutcome DealerOdds::draw(int hard, bool ace, Composition &c){
+    DealerOutcome r;
+    for(int v=0;v<Composition::VALUES;v++){
+        if(c.count[v]==0){
+            continue;
+        }
+        double p = (double)c.count[v]/c.total;
+        int h = hard+v+1;
+        bool a = ace || v==0;
+        int sum = (a && h<=11) ? h+10 : h;
+        if(sum>Rules::BLACKJACK){
+            r.p[DealerOutcome::BUST] += p;
+        }
+        else if(!Rules::dealerDraws(sum)){
+            r.p[sum-Rules::DEALER_STANDS] += p;
+        }
+        else if(c.total==1){
+            // Shoe runs out: counts as standing below 17, never happens in a real shoe
+            continue;
+        }
+        else{
+            c.remove(v);
+            DealerOutcome sub = draw(h, a, c);
+            c.add(v);
+            for(int i=0;i<6;i++){
+                r.p[i] += p*sub.p[i];
+            }
+        }
+    }
+    return r;
+}
+
+//////////////* Queries *////
+
+// Dealer shows `upValue` (1 = ace ... 10) and draws the hole card from `c`
+DealerOutcome DealerOdds::get(int upValue, const Composition &c){
+    return getFromHand(upValue, upValue==1, c);
+}
+
+// Dealer already holds cards worth `hard`, drawing from `c` until standing
+DealerOutcome DealerOdds::getFromHand(int hard, bool ace, const Composition &c){
+    int sum = (ace && hard<=11) ? hard+10 : hard;
+    DealerOutcome r;
+    if(sum>Rules::BLACKJACK){
+        r.p[DealerOutcome::BUST] = 1.0;
+        return r;
+    }
+    if(!Rules::dealerDraws(sum)){
+        r.p[sum-Rules::DEALER_STANDS] = 1.0;
+        return r;
+    }
+    Key key = {c.getKey(), (uint16_t)(hard*2+ace)};
+    auto it = cache.find(key);
+    if(it!=cache.end()){
+        return it->second;
+    }
+    Composition copy = c;
+    return cache.emplace(key, draw(hard, ace, copy)).first->second;
+}
+
+void DealerOdds::clear(){
+    cache.clear();
+}
+
+size_t DealerOdds::getCacheSize() const{
+    return cache.size();
+}
+
+//////////////* Infinite Deck *////
+
+// Distribution from a dealer hand when every draw has fixed odds (1/13 per
+// number, 4/13 for tens)
+static DealerOutcome infiniteFrom(int hard, bool ace){
+    DealerOutcome r;
+    for(int v=1;v<=10;v++){
+        double p = v==10 ? 4.0/13 : 1.0/13;
+        int h = hard+v;
+        bool a = ace || v==1;
+        int sum = (a && h<=11) ? h+10 : h;
+        if(sum>Rules::BLACKJACK){
+            r.p[DealerOutcome::BUST] += p;
+        }
+        else if(!Rules::dealerDraws(sum)){
+            r.p[sum-Rules::DEALER_STANDS] += p;
+        }
+        else{
+            DealerOutcome sub = infiniteFrom(h, a);
+            for(int i=0;i<6;i++){
+                r.p[i] += p*sub.p[i];
+            }
+        }
+    }
+    return r;
+}
+
+// Precomputed table for the infinite-deck case: every dealer hand that
+// still draws (hard 2 to 16), built once on first use
+static const DealerOutcome& infiniteTable(int hard, bool ace){
+    static const struct Table{
+        DealerOutcome from[Rules::DEALER_STANDS][2];
+        Table(){
+            for(int h=1;h<Rules::DEALER_STANDS;h++){
+                for(int a=0;a<2;a++){
+                    from[h][a] = infiniteFrom(h, a);
+                }
+            }
+        }
+    } table;
+    return table.from[hard][ace];
+}
+
+// Dealer shows `upValue` (1 = ace ... 10) with an infinite shoe
+const DealerOutcome& DealerOdds::getInfinite(int upValue){
+    return infiniteTable(upValue, upValue==1);
+}
+
+// Dealer already holds cards worth `hard`, drawing from an infinite shoe
+DealerOutcome DealerOdds::getInfinite(int hard, bool ace){
+    int sum = (ace && hard<=11) ? hard+10 : hard;
+    DealerOutcome r;
+    if(sum>Rules::BLACKJACK){
+        r.p[DealerOutcome::BUST] = 1.0;
+        return r;
+    }
+    if(!Rules::dealerDraws(sum)){
+        r.p[sum-Rules::DEALER_STANDS] = 1.0;
+        return r;
+    }
+    return infiniteTable(hard, ace);
+}
@@ -1,35 +1,107 @@
 #include "headers/deck.h"
-#include <iostream>
-#include <algorithm>
-
-// Constructs a Deck
-/*
- * O: Oros;
- * E: Espases;
- * B: Bastos;
- * C: Copes;
- */
-void Deck::initializeDeck(){
-    deck.clear();
-    char suits[4] = {'O','E','B','C'};
-    for(int i=0;i<4;i++){
-        for(int j=0;j<13;j++){
-            Card c(j+1,suits[i]);
-            deck.push_back(c);
+#include <cstring>
+
+// Cards of a freshly opened deck, built once per deck type
+struct DeckLayout{
+    Card cards[Deck::MAX_CARDS];
+    int size;
+    uint64_t mask;
+
+    DeckLayout(Deck::Type t){
+        size = 0;
+        mask = 0;
+        for(int i=0;i<4;i++){
+            for(int j=1;j<=13;j++){
+                if(t==Deck::SPANISH && (j==8 || j==9 || j==13)){
+                    continue;
+                }
+                cards[size] = Card(j, CardTable::SUITS[i]);
+                mask |= 1ULL<<cards[size].getCode();
+                size++;
+            }
         }
     }
-    std::random_shuffle(deck.begin(), deck.end());
+};
+
+static const DeckLayout layouts[2] = {DeckLayout(Deck::FRENCH), DeckLayout(Deck::SPANISH)};
+
+//////////////* Constructors *////
+
+// Default Constructor (seed 0, table 0 until seed() is called)
+Deck::Deck(){
+    type = FRENCH;
+    initializeDeck();
+}
+
+Deck::Deck(Type t){
+    type = t;
+    initializeDeck();
+}
+
+// Selects the random stream of a table
+void Deck::seed(uint64_t s, uint64_t table){
+    rng.setSeed(s, table);
+}
+
+// Positions the stream at the first draw of a hand, so the cards dealt in
+// hand N only depend on (seed, table, N) and the cards left in the deck
+void Deck::setHand(uint64_t hand){
+    rng.setHand(hand);
+}
+
+// Puts every card back in the deck, in the canonical order
+void Deck::initializeDeck(){
+    const DeckLayout &l = layouts[type];
+    memcpy(order, l.cards, l.size);
+    left = l.size;
+    present = l.mask;
 }
 
+//////////////* Getter Functions *////
+
 // Getter Function for size of deck
-int Deck::getSize(){
-    return deck.size();
+int Deck::getSize() const {
+    return left;
+}
+
+Deck::Type Deck::getType(){
+    return type;
 }
 
-// Deals by returning one card from the deck
+// Checks whether a card is still in the deck
+bool Deck::hasCard(Card c){
+    return (present>>c.getCode())&1;
+}
+
+//////////////* Dealing *////
+
+// Deals by returning one random card from the ones left
 Card Deck::deal(){
-    int val = (rand()%(deck.size()));
-    Card t = deck[val];
-    deck.erase(deck.begin()+val);
-    return t;
+    int val = rng.below(left);
+    Card c = order[val];
+    left--;
+    order[val] = order[left];
+    order[left] = c;
+    present &= ~(1ULL<<c.getCode());
+    return c;
+}
+
+//////////////* Saving & Loading *////
+
+// Copies the cards left in the deck, returns how many
+int Deck::getCards(Card out[]){
+    memcpy(out, order, left);
+    return left;
+}
+
+// Replaces the deck contents with the given cards (e.g. from a save file)
+void Deck::setCards(const Card in[], int n){
+    left = 0;
+    present = 0;
+    for(int i=0;i<n && left<MAX_CARDS;i++){
+        if(!((present>>in[i].getCode())&1)){
+            order[left++] = in[i];
+            present |= 1ULL<<in[i].getCode();
+        }
+    }
 }
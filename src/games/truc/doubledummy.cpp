@@ -0,0 +1,226 @@
+#include "headers/doubledummy.h"
+#include "headers/rng.h"
+#include <atomic>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+//////////////* Zobrist Keys *////
+
+struct ZobristKeys{
+    uint64_t hand[TrucState::MAX_PLAYERS][CardTable::CODES];   // Card still in a seat's hand
+    uint64_t table[TrucState::MAX_PLAYERS][CardTable::CODES];  // Card a seat put on the table
+    uint64_t turn[TrucState::MAX_PLAYERS];
+    uint64_t leader[TrucState::MAX_PLAYERS];
+    uint64_t mano[TrucState::MAX_PLAYERS];
+    uint64_t baza[TrucState::HAND_CARDS][3];    // Team 0, team 1 or parda
+    uint64_t fourPlayers;
+
+    ZobristKeys(){
+        Rng rng(0x7275635a6f627269ULL, 0);
+        for(int p=0;p<TrucState::MAX_PLAYERS;p++){
+            for(int c=0;c<CardTable::CODES;c++){
+                hand[p][c] = next(rng);
+                table[p][c] = next(rng);
+            }
+            turn[p] = next(rng);
+            leader[p] = next(rng);
+            mano[p] = next(rng);
+        }
+        for(int b=0;b<TrucState::HAND_CARDS;b++){
+            for(int r=0;r<3;r++){
+                baza[b][r] = next(rng);
+            }
+        }
+        fourPlayers = next(rng);
+    }
+    static uint64_t next(Rng &rng){
+        uint64_t hi = rng.next();
+        return (hi<<32)|rng.next();
+    }
+};
+
+static const ZobristKeys zobrist;
+
+//////////////* Constructor *////
+
+DoubleDummy::DoubleDummy(){
+    Entry empty = {0, -1};
+    table.assign(1<<TABLE_BITS, empty);
+    nodes = 0;
+}
+
+uint64_t DoubleDummy::hash(const TrucState &s) const{
+    uint64_t h = zobrist.turn[s.turn]^zobrist.leader[s.leader]^zobrist.mano[s.mano];
+    if(s.players==4){
+        h ^= zobrist.fourPlayers;
+    }
+    for(int p=0;p<s.players;p++){
+        for(int i=0;i<TrucState::HAND_CARDS;i++){
+            if(!s.hasPlayed(p, i)){
+                h ^= zobrist.hand[p][s.hands[p][i].getCode()];
+            }
+        }
+    }
+    for(int j=0;j<s.inBaza;j++){
+        int seat = (s.leader+j)%s.players;
+        h ^= zobrist.table[seat][s.table[seat].getCode()];
+    }
+    for(int b=0;b<s.baza;b++){
+        h ^= zobrist.baza[b][s.bazaWinner[b]];
+    }
+    return h;
+}
+
+//////////////* Search *////
+
+// Team that wins the bazas from `s` with perfect play, and its first card
+int DoubleDummy::solve(const TrucState &s, uint8_t *bestMove){
+    nodes = 0;
+    if(s.isHandOver()){
+        return s.handWinner;
+    }
+    uint8_t moves[TrucState::HAND_CARDS];
+    int n = 0;
+    moves[n++] = s.heuristicCard();
+    for(int i=0;i<TrucState::HAND_CARDS;i++){
+        if(!s.hasPlayed(s.turn, i) && i!=moves[0]){
+            moves[n++] = i;
+        }
+    }
+    int team = s.getTeam(s.turn);
+    int winner = 1-team;
+    if(bestMove!=NULL){
+        *bestMove = moves[0];
+    }
+    for(int i=0;i<n;i++){
+        TrucState next = s;
+        next.apply(moves[i]);
+        if(search(next, 0, 1)==team){
+            winner = team;
+            if(bestMove!=NULL){
+                *bestMove = moves[i];
+            }
+            break;
+        }
+    }
+    return winner;
+}
+
+// Winning team (0 or 1): team 1 maximises the value and team 0 minimises it.
+// With only two values every cutoff returns the exact result.
+int DoubleDummy::search(const TrucState &s, int alpha, int beta){
+    nodes++;
+    if(s.isHandOver()){
+        return s.handWinner;
+    }
+    uint64_t key = hash(s);
+    Entry &e = table[key&((1<<TABLE_BITS)-1)];
+    if(e.key==key && e.winner>=0){
+        return e.winner;
+    }
+    // Heuristic card first, then the others from strongest to weakest
+    uint8_t moves[TrucState::HAND_CARDS];
+    int n = 0;
+    moves[n++] = s.heuristicCard();
+    for(int i=0;i<TrucState::HAND_CARDS;i++){
+        if(!s.hasPlayed(s.turn, i) && i!=moves[0]){
+            int j = n++;
+            while(j>1 && s.hands[s.turn][moves[j-1]].getTrucRank()<s.hands[s.turn][i].getTrucRank()){
+                moves[j] = moves[j-1];
+                j--;
+            }
+            moves[j] = i;
+        }
+    }
+    bool maximise = s.getTeam(s.turn)==1;
+    int value = maximise ? 0 : 1;
+    for(int i=0;i<n;i++){
+        TrucState next = s;
+        next.apply(moves[i]);
+        int v = search(next, alpha, beta);
+        if(maximise){
+            if(v>value) value = v;
+            if(value>alpha) alpha = value;
+        }
+        else{
+            if(v<value) value = v;
+            if(value<beta) beta = value;
+        }
+        if(alpha>=beta){
+            break;
+        }
+    }
+    e.key = key;
+    e.winner = value;
+    return value;
+}
+
+//////////////* Batch Mode *////
+
+// Parses "mano card card ..." with 6 or 12 cards given seat by seat, e.g.
+// "0 1E 7O 3C 12B 4O 5C" for two players. Cards are number plus suit letter,
+// each at most once (tracked by its bit in a mask of card codes).
+bool DoubleDummy::parseDeal(const std::string &line, TrucState &s, std::string &error){
+    std::istringstream in(line);
+    int mano;
+    if(!(in>>mano)){
+        error = "missing mano seat";
+        return false;
+    }
+    Card cards[TrucState::MAX_PLAYERS*TrucState::HAND_CARDS];
+    uint64_t seen = 0;
+    int n = 0;
+    std::string token;
+    while(n<TrucState::MAX_PLAYERS*TrucState::HAND_CARDS && in>>token){
+        int number = atoi(token.c_str());
+        char suit = token[token.size()-1];
+        if(number<1 || number>12 || number==8 || number==9 || (suit!='O' && suit!='E' && suit!='B' && suit!='C')){
+            error = "invalid card "+token;
+            return false;
+        }
+        Card c(number, suit);
+        if(seen>>c.getCode()&1){
+            error = "card "+token+" dealt twice";
+            return false;
+        }
+        seen |= 1ULL<<c.getCode();
+        cards[n++] = c;
+    }
+    if(n!=6 && n!=12){
+        error = "expected 6 or 12 cards";
+        return false;
+    }
+    if(in>>token){
+        error = "unexpected "+token+" after the cards";
+        return false;
+    }
+    s.newGame(n/TrucState::HAND_CARDS, 24);
+    if(mano<0 || mano>=s.players){
+        error = "mano seat out of range";
+        return false;
+    }
+    for(int i=0;i<n;i++){
+        s.hands[i/TrucState::HAND_CARDS][i%TrucState::HAND_CARDS] = cards[i];
+    }
+    s.startHand(mano);
+    return true;
+}
+
+// Solves every deal on `threads` workers, each with its own table
+void DoubleDummy::solveBatch(const std::vector<TrucState> &deals, std::vector<int8_t> &winners, int threads){
+    winners.assign(deals.size(), -1);
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for(int t=0;t<(threads>0 ? threads : 1);t++){
+        workers.push_back(std::thread([&deals, &winners, &next](){
+            DoubleDummy dd;
+            for(size_t i=next++;i<deals.size();i=next++){
+                winners[i] = dd.solve(deals[i], NULL);
+            }
+        }));
+    }
+    for(std::thread &w: workers){
+        w.join();
+    }
+}
@@ -0,0 +1,145 @@
+#include "headers/equity.h"
+#include "headers/truchands.h"
+#include "headers/trucstate.h"
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char EQUITY_MAGIC[8] = "TRUCEQ1";
+
+//////////////* Constructor & Destructor *////
+
+EquityTable::EquityTable(){
+    map = NULL;
+    mapSize = 0;
+    equity = NULL;
+}
+
+EquityTable::~EquityTable(){
+    unload();
+}
+
+//////////////* Loading *////
+
+// Maps a generated file read-only, returns false if it is missing or invalid
+bool EquityTable::load(const std::string &path){
+    unload();
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd<0){
+        return false;
+    }
+    struct stat st;
+    if(fstat(fd, &st)<0 || (size_t)st.st_size<sizeof(Header)){
+        close(fd);
+        return false;
+    }
+    void *m = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(m==MAP_FAILED){
+        return false;
+    }
+    const Header *h = (const Header*)m;
+    size_t expected = sizeof(Header)+(size_t)TrucHands::HANDS*CONFIGS*sizeof(uint16_t);
+    if(memcmp(h->magic, EQUITY_MAGIC, sizeof(EQUITY_MAGIC))!=0 || h->hands!=TrucHands::HANDS
+       || h->configs!=CONFIGS || (size_t)st.st_size<expected){
+        munmap(m, st.st_size);
+        return false;
+    }
+    map = m;
+    mapSize = st.st_size;
+    equity = (const uint16_t*)((const char*)m+sizeof(Header));
+    return true;
+}
+
+void EquityTable::unload(){
+    if(map!=NULL){
+        munmap(map, mapSize);
+    }
+    map = NULL;
+    mapSize = 0;
+    equity = NULL;
+}
+
+// Equity of a hand for a table of `players` (2 or 4) seated `seat` after the mà
+double EquityTable::get(const Card cards[3], int players, int seat) const{
+    return getByIndex(TrucHands::index(cards), config(players, seat));
+}
+
+//////////////* Generation *////
+
+// Fraction of `samples` random deals won by `hero` in the given seat
+static double rollout(const Card hero[3], int players, int seat, int samples, Deck &deck){
+    int wins = 0;
+    TrucState s;
+    s.newGame(players, 24);
+    for(int n=0;n<samples;n++){
+        deck.initializeDeck();
+        for(int p=0;p<players;p++){
+            for(int i=0;i<TrucState::HAND_CARDS;i++){
+                if(p==seat){
+                    s.hands[p][i] = hero[i];
+                    continue;
+                }
+                Card c;
+                do{
+                    c = deck.deal();
+                } while(c==hero[0] || c==hero[1] || c==hero[2]);
+                s.hands[p][i] = c;
+            }
+        }
+        s.startHand(0);
+        while(!s.isHandOver()){
+            s.apply(s.heuristicCard());
+        }
+        wins += s.handWinner==s.getTeam(seat);
+    }
+    return (double)wins/samples;
+}
+
+// Fills the whole table on `threads` workers and writes it to `path`.
+// Hand h uses random stream (seed, h), so the file doesn't depend on threads.
+bool EquityTable::generate(const std::string &path, int samples, int threads, uint64_t seed){
+    std::vector<uint16_t> rows((size_t)TrucHands::HANDS*CONFIGS);
+    std::atomic<int> next(0);
+    std::vector<std::thread> workers;
+    for(int t=0;t<(threads>0 ? threads : 1);t++){
+        workers.push_back(std::thread([&rows, &next, samples, seed](){
+            Deck deck(Deck::SPANISH);
+            for(int h=next++;h<TrucHands::HANDS;h=next++){
+                Card hero[3];
+                TrucHands::handAt(h, hero);
+                deck.seed(seed, h);
+                for(int c=0;c<CONFIGS;c++){
+                    int players = c<2 ? 2 : 4;
+                    int seat = c<2 ? c : c-2;
+                    deck.setHand(c);
+                    rows[(size_t)h*CONFIGS+c] = (uint16_t)(rollout(hero, players, seat, samples, deck)*65535.0+0.5);
+                }
+            }
+        }));
+    }
+    for(std::thread &w: workers){
+        w.join();
+    }
+    Header h;
+    memcpy(h.magic, EQUITY_MAGIC, sizeof(EQUITY_MAGIC));
+    h.hands = TrucHands::HANDS;
+    h.configs = CONFIGS;
+    h.samples = samples;
+    h.reserved = 0;
+    std::fstream f1;
+    f1.open(path, std::ios::out | std::ios::binary);
+    if(f1.fail()){
+        return false;
+    }
+    f1.write((char*)&h, sizeof(h));
+    f1.write((char*)rows.data(), rows.size()*sizeof(uint16_t));
+    f1.close();
+    return !f1.fail();
+}
@@ -0,0 +1,18 @@
+#include "headers/truc.h"
+#include "headers/equity.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Generates the Truc equity table file
+int generateEquity(const std::string &path, int samples, int threads, uint64_t seed){
+    auto start = std::chrono::steady_clock::now();
+    if(!EquityTable::generate(path, samples, threads, seed)){
+        std::cerr<<"Could not write "<<path<<"\n";
+        return 1;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    std::cout<<"Equity table written to "<<path<<" ("<<samples<<" samples per hand and seat, "
+             <<std::fixed<<std::setprecision(1)<<secs<<" s)\n";
+    return 0;
+}
@@ -1,5 +1,5 @@
 #include "headers/game.h"
-#include "headers/compatible.h"
+#include "headers/input.h"
 #include <vector>
 #include <iostream>
 #include <fstream>
@@ -7,83 +7,50 @@
 
 //////////////* Default Constructor *////
 
-Game::Game(){
+Game::Game(uint64_t seed): deck(Variant::DECK){
+    round = 0;
+    decider = &terminal;
+    show = true;
+    deck.seed(seed, 0);
     deck.initializeDeck();
 }
 
-//////////////* Deals dealer towards the end *////
+//////////////* Dealer Delay *////
 
-bool Game::dealDealer(){
-    if(dealer.getSum()<player.getSum()){
-        while (dealer.getSum() < 17){
-            dealer.addCard(deck.deal());
-            if (checkWins()){
-                return false;
-            }
-        }
-        return true;
-    }
-    else{
-        if(checkWins()){
-            return false;
-        }
+// Waits ms on a session timer; true when a key came first (the key is used up)
+bool Game::pause(int ms){
+    Input &input = Input::session();
+    int timer = input.addTimer(ms);
+    Input::Event e;
+    input.wait(e, -1);
+    if(e.type==Input::KEY){
+        input.cancelTimer(timer);
         return true;
     }
+    return false;
 }
 
 //////////////* Checkers *////
 
-char Game::compareSum(){
-    if(player.getSum()>dealer.getSum()){
-        printTop();
-        std::cout<<lightYellow<<Print::you_win()<<def<<"\n    (Dealer has "<<dealer.getSum()<<")\n";
-        return 'p';
-    }
-    else if(dealer.getSum()>player.getSum()){
-        printTop();
-        std::cout<<lightRed<<Print::dealer_wins()<<def<<"\n    ("<<dealer.getSum()<<")\n";
-        return 'd';
-    }
-    else{
-        printTop();
-        std::cout<<lightMagenta<<Print::draw()<<def;
-        return 'n';
+// Tells a human seat how the round ended: a bust, a 21 or the higher sum
+void Game::showResult(char result){
+    if(!show){
+        return;
     }
-}
-
-bool Game::checkWins(){
-    switch(checkEnd()){
-        case 'f': return false;
-        case 'd': player.incrementLoses(); return true;
-        case 'p': player.incrementWins();
-                  player.addCash((player.getBet()*2));
-                  return true;
+    printTop();
+    if(dealer.getSum()>Rules::BLACKJACK || player.getSum()>Rules::BLACKJACK){
+        screen.out()<<red<<Print::bust()<<def<<"\n    [Dealer : "<<dealer.getSum()<<" | "<<player.getName()<<" : "<<player.getSum()<<"]\n";
+        return;
     }
-    return false;
-}
-
-char Game::checkEnd(){
-    if(dealer.getSum()>21 || player.getSum()>21){
-        printTop();
-        std::cout<<red<<Print::bust()<<def<<"\n    [Dealer : "<<dealer.getSum()<<" | "<<player.getName()<<" : "<<player.getSum()<<"]\n";
-        if(dealer.getSum()>21){
-            return 'p';
-        }
-        else if(player.getSum()>21){
-            return 'd';
-        }
+    if(dealer.getSum()==Rules::BLACKJACK || player.getSum()==Rules::BLACKJACK){
+        screen.out()<<lightGreen<<Print::blackjack()<<def<<"\n    [Dealer : "<<dealer.getSum()<<" | "<<player.getName()<<" : "<<player.getSum()<<"]\n";
+        return;
     }
-    else if(dealer.getSum()==21 || player.getSum()==21){
-        printTop();
-        std::cout<<lightGreen<<Print::blackjack()<<def<<"\n    [Dealer : "<<dealer.getSum()<<" | "<<player.getName()<<" : "<<player.getSum()<<"]\n";
-        if(dealer.getSum()==21){
-            return 'd';
-        }
-        else if(player.getSum()==21){
-            return 'p';
-        }
+    switch(result){
+        case 'p': screen.out()<<lightYellow<<Print::you_win()<<def<<"\n    (Dealer has "<<dealer.getSum()<<")\n"; break;
+        case 'd': screen.out()<<lightRed<<Print::dealer_wins()<<def<<"\n    ("<<dealer.getSum()<<")\n"; break;
+        case 'n': screen.out()<<lightMagenta<<Print::draw()<<def; break;
     }
-    return 'f';
 }
 
 //////////////* Game Starters *////
@@ -91,20 +58,23 @@ char Game::checkEnd(){
 bool Game::startBet(){
     if(player.getCash()>0){
         while(true){
-            printTop();
-            std::cout<<"Place your bet!\t\t $"<<green<<player.getBet()<<def<<"\n[W = Raise Bet | S = Decrease Bet | R = Done]\n";
-            int c = toupper(getch());
-            switch(c){
-                case 87: if(player.getCash()>=5){
-                            player.setBet(5);
-                         }
-                         break;
-                case 83: if(player.getBet()>=5){
-                            player.setBet(-5);
-                         }
-                         break;
+            if(show){
+                printTop();
+                screen.out()<<"Place your bet!\t\t $"<<green<<player.getBet()<<def<<"\n[W = Raise Bet | S = Decrease Bet | R = Done]\n";
+                screen.present();
+            }
+            int step = decider->chooseBet(player.getCash(), player.getBet(), deck.getSize());
+            switch(step){
+                case Decider::BET_RAISE: if(player.getCash()>=5){
+                                            player.setBet(5);
+                                         }
+                                         break;
+                case Decider::BET_LOWER: if(player.getBet()>=5){
+                                            player.setBet(-5);
+                                         }
+                                         break;
             }
-            if(c==82) break;
+            if(step==Decider::BET_DONE) break;
         }
         return true;
     }
@@ -113,67 +83,75 @@ bool Game::startBet(){
     }
 }
 
-bool Game::startGame(){
-    player.addCard(deck.deal());
-    dealer.addCard(deck.deal());
-    player.addCard(deck.deal());
-    dealer.addCard(deck.deal());
-    printBody();
-    if(checkWins()){
-        return false;
-    }
-    while(true){
-        std::cout << lightYellow << "\n\nH : Hit | S : Stand\n"<<def;
-        int c = toupper(getch());
-        if(c==72){
-            player.addCard(deck.deal());
+// Plays a round through the engine with the seat's decider. A human seat
+// sees the table before each decision, then the hole card and each card the
+// dealer draws after DEALER_DELAY_MS, until a key skips to the result.
+char Game::playRound(){
+    Variant::Hands hands = {player, dealer};
+    Variant::deal(hands, deck);
+    auto decide = [this](const Hand &p, Card up){
+        if(show){
             printBody();
-            if(checkWins()) return false;
+            screen.out() << lightYellow << "\n\nH : Hit | S : Stand\n"<<def;
+            screen.present();
         }
-        else if(c==83){
-            break;
+        return decider->chooseHit(p, up);
+    };
+    bool skip = !show;
+    auto watch = [this, &skip](const Hand &d){
+        if(!skip){
+            printDealer();
+            skip = pause(DEALER_DELAY_MS);
         }
-    }
-    return true;
+    };
+    return Variant::play(hands, deck, decide, watch);
 }
 
 void Game::beginGame(){
-    char cont;
+    bool cont;
     do{
         if(deck.getSize()<36){
                 deck.initializeDeck();
         }
+        deck.setHand(round++);
         player.clearCards();
         dealer.clearCards();
         if(!startBet()){
-            std::cout<<lightRed<<"\nBankrupt! Game over.\n"<<def;
+            if(show){
+                screen.out()<<lightRed<<"\nBankrupt! Game over.\n"<<def;
+            }
             break;
         }
-        if (startGame()){
-            if (dealDealer()){
-                switch (compareSum()){
-                case 'p': player.incrementWins(); 
-                          player.addCash((player.getBet()*2));
-                          break;
-                case 'd': player.incrementLoses(); break;
-                case 'n': player.addCash(player.getBet()); break;
-                }
-            }
+        char result = playRound();
+        showResult(result);
+        switch (result){
+        case 'p': player.incrementWins(); break;
+        case 'd': player.incrementLoses(); break;
         }
-        std::cout<<lightRed<<Print::dealer_border()<<def;
-        dealer.printCards();
-        std::cout<<lightCyan<<Print::player_border()<<def;
-        player.printCards();
-        std::cout << yellow << "\nYour wins: " << player.getWins()<< lightRed <<"\nYour loses: "<<player.getLoses()<<def<<"\n";
-        if(s.check(player)){
-            std::cout<< lightYellow << "High Score!\n"<<def;
+        player.addCash(Variant::ScoringPolicy::payout(result, player.getBet()));
+        if(show){
+            screen.out()<<lightRed<<Print::dealer_border()<<def;
+            dealer.printCards(screen.out());
+            screen.out()<<lightCyan<<Print::player_border()<<def;
+            player.printCards(screen.out());
+            screen.out() << yellow << "\nYour wins: " << player.getWins()<< lightRed <<"\nYour loses: "<<player.getLoses()<<def<<"\n";
+            if(s.check(player)){
+                screen.out()<< lightYellow << "High Score!\n"<<def;
+            }
+            screen.out()<<"\nContinue playing? [Y/N]: ";
+            screen.present();
         }
-        std::cout<<"\nContinue playing? [Y/N]: ";
-        std::cin>>cont;
-    } while (cont != 'N' && cont != 'n');
-    char saveChoice;
-    std::cout<<"\nSave game? [Y/N]: ";
-    std::cin>>saveChoice;
+        cont = decider->keepPlaying();
+    } while (cont);
+    // Seats without a human only report the totals
+    if(!show){
+        std::cout<<player.getName()<<": "<<round<<" rounds, "<<player.getWins()<<" wins, "<<player.getLoses()
+                 <<" loses, cash "<<player.getCash()<<"\n";
+        return;
+    }
+    screen.out()<<"\nSave game? [Y/N]: ";
+    screen.present();
+    char saveChoice = Input::session().answer();
     if(saveChoice == 'Y' || saveChoice == 'y'){
         saveGame();
     }
@@ -181,47 +159,53 @@ void Game::beginGame(){
 
 //////////////* Main Method to be Called *////
 
+// Shows the menu until a game is played (`message` is shown when rep is set)
 void Game::beginMenu(bool rep, std::string message){
-    clearscr();
-    std::cout<<yellow<<Print::title_blackjack()<<def<<"\n";
-    std::cout<<Print::begin_menu()<<"\n";
-    if(rep){
-        std::cout<<red<<message<<def<<"\n";
-    }
-    char c;
-    std::cout<<"Input : ";
-    std::cin>>c;
-    switch(c){
-        case '1': char nm[100];
-                  std::cout<<"Enter player name: ";
-                  std::cin>>nm;
-                  player.setName(nm);
-                  beginGame();
-                  break;
-        case '2': loadGame();
-                  beginGame();
-                  break;
-        case '3': printStatistics();
-                  beginMenu(false, "");
-                  break;
-        case '4': printInstructions();
-                  beginMenu(false, "");
-                  break;
-        case '5': exit(0);
-                  break;
-        default: beginMenu(true, "Invalid input.");
+    while(true){
+        screen.begin()<<yellow<<Print::title_blackjack()<<def<<"\n";
+        screen.out()<<Print::begin_menu()<<"\n";
+        if(rep){
+            screen.out()<<red<<message<<def<<"\n";
+        }
+        screen.out()<<"Input : ";
+        screen.present();
+        char c = Input::session().answer();
+        rep = false;
+        switch(c){
+            case '1': screen.out()<<"Enter player name: ";
+                      screen.present();
+                      player.setName(Input::session().word());
+                      beginGame();
+                      return;
+            case '2': if(!loadGame()){
+                          rep = true;
+                          message = "File does not exist.";
+                          break;
+                      }
+                      beginGame();
+                      return;
+            case '3': printStatistics();
+                      break;
+            case '4': printInstructions();
+                      break;
+            case '5': exit(0);
+                      break;
+            default: rep = true;
+                     message = "Invalid input.";
+        }
     }
 }
 
 //////////////* Data File Handling *////
 
 void Game::saveGame(){
+    screen.invalidate();
     std::fstream f1,f2;
     std::string filename;
     std::string path = "data/";
     do{
     std::cout<<"Enter filename: ";
-    std::cin>>filename;
+    filename = Input::session().word();
     std::transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
     }while(filename.compare("statistics")==0);
     path+=filename+".bin";
@@ -230,11 +214,12 @@ void Game::saveGame(){
     int sWins = player.getWins();
     int sLoses = player.getLoses();
     int nameSize = sName.size();
+    Card cards[Deck::MAX_CARDS];
+    int nCards = deck.getCards(cards);
     f2.open(path, std::ios::in | std::ios::binary);
     if(!f2.fail()){
-        char choice;
         std::cout<<red<<"File already exists."<<def<<" Do you want to overwrite it? [Y/N]: ";
-        std::cin>>choice;
+        char choice = Input::session().answer();
         if(choice == 'N' || choice == 'n'){
             saveGame();
         }
@@ -246,16 +231,20 @@ void Game::saveGame(){
     f1.write((char*)&sCash, sizeof(sCash));
     f1.write((char*)&sWins, sizeof(sWins));
     f1.write((char*)&sLoses, sizeof(sLoses));
+    f1.write((char*)&round, sizeof(round));
+    f1.write((char*)&nCards, sizeof(nCards));
+    f1.write((char*)cards, nCards*sizeof(Card));
     f1.close();
 }
 
-void Game::loadGame(){
+bool Game::loadGame(){
+    screen.invalidate();
     std::fstream f1;
     std::string filename;
     std::string path = "data/";
     do{
     std::cout<<"Enter filename: ";
-    std::cin>>filename;
+    filename = Input::session().word();
     std::transform(filename.begin(), filename.end(), filename.begin(), ::tolower);
     }while(filename.compare("statistics")==0);
     path+=filename+".bin";
@@ -272,6 +261,16 @@ void Game::loadGame(){
         f1.read((char*)&sCash, sizeof(sCash));
         f1.read((char*)&sWins, sizeof(sWins));
         f1.read((char*)&sLoses, sizeof(sLoses));
+        // Older saves end here; newer ones also keep the deck being played
+        uint64_t sRound;
+        int nCards;
+        Card cards[Deck::MAX_CARDS];
+        f1.read((char*)&sRound, sizeof(sRound));
+        f1.read((char*)&nCards, sizeof(nCards));
+        if(f1 && nCards>0 && nCards<=Deck::MAX_CARDS && f1.read((char*)cards, nCards*sizeof(Card))){
+            round = sRound;
+            deck.setCards(cards, nCards);
+        }
         f1.close();
         player.setName(sName);
         player.addCash(sCash - player.getCash());
@@ -281,42 +280,57 @@ void Game::loadGame(){
         while(player.getLoses()!=sLoses){
             player.incrementLoses();
         }
+        return true;
     }
-    else{
-        beginMenu(true, "File does not exist.");
-    }
+    return false;
 }
 
 //////////////* Printing Stuff *////
 
 void Game::printStatistics(){
-    clearscr();
-    std::cout<<yellow<<Print::title_blackjack()<<def<<"\n";
-    std::cout<<"\n"<<lightGreen<<Print::statistics()<<def<<"\n";
-    s.print();
-    std::cout<<"\n\n\t(Press any key to continue)\n";
-    getch();
+    screen.begin()<<yellow<<Print::title_blackjack()<<def<<"\n";
+    screen.out()<<"\n"<<lightGreen<<Print::statistics()<<def<<"\n";
+    s.print(screen.out());
+    screen.out()<<"\n\n\t(Press any key to continue)\n";
+    screen.present();
+    Input::session().key();
 }
 
 void Game::printInstructions(){
-    clearscr();
-    std::cout<<yellow<<Print::title_blackjack()<<def<<"\n";
-    std::cout<<"\n"<<lightGreen<<Print::instructions()<<def<<"\n";
-    getch();
+    screen.begin()<<yellow<<Print::title_blackjack()<<def<<"\n";
+    screen.out()<<"\n"<<lightGreen<<Print::instructions()<<def<<"\n";
+    screen.present();
+    Input::session().key();
 }
 
 void Game::printTop(){
-    clearscr();
-    std::cout<<yellow<<Print::title_blackjack()<<def<<"\n";
-    std::cout<<lightRed<<"\t\tCards: "<<deck.getSize()<<lightGreen<<" \tCash: "<<player.getCash()<<lightMagenta
+    if(!show){
+        return;
+    }
+    screen.begin()<<yellow<<Print::title_blackjack()<<def<<"\n";
+    screen.out()<<lightRed<<"\t\tCards: "<<deck.getSize()<<lightGreen<<" \tCash: "<<player.getCash()<<lightMagenta
              <<" \tBet: "<<player.getBet()<<lightBlue<<" \tName: "<<player.getName()<<def<<"\n\n\n";
 }
 
+// The dealer's turn: every dealer card face up
+void Game::printDealer(){
+    printTop();
+    screen.out()<<lightRed<<Print::dealer_border()<<def;
+    dealer.printCards(screen.out());
+    screen.out()<<lightCyan<<Print::player_border()<<def;
+    player.printCards(screen.out());
+    screen.out()<<lightGreen<<"\nDealer: "<<lightRed<<dealer.getSum()<<def<<"\t(any key to skip)\n";
+    screen.present();
+}
+
 void Game::printBody(){
+    if(!show){
+        return;
+    }
     printTop();
-    std::cout<<lightRed<<Print::dealer_border()<<def;
-    dealer.printFirstCard();
-    std::cout<<lightCyan<<Print::player_border()<<def;
-    player.printCards();
-    std::cout << lightGreen<< "\nSum: "<<lightRed<< player.getSum()<<def<<"\n";
+    screen.out()<<lightRed<<Print::dealer_border()<<def;
+    dealer.printFirstCard(screen.out());
+    screen.out()<<lightCyan<<Print::player_border()<<def;
+    player.printCards(screen.out());
+    screen.out() << lightGreen<< "\nSum: "<<lightRed<< player.getSum()<<def<<"\n";
 }
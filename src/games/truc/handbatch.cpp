@@ -0,0 +1,162 @@
+#include "headers/handbatch.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HANDBATCH_X86 1
+#endif
+
+//////////////* Constructor & Filling *////
+
+HandBatch::HandBatch(int n){
+    size = 0;
+    slots = 0;
+    capacity = (std::max(n, 1)+LANES-1)/LANES*LANES;
+    numbers.assign(MAX_SLOTS*capacity, 0);
+    totals.assign(capacity, 0);
+    flags.assign(capacity, 0);
+}
+
+// Empties the batch, keeping its memory
+void HandBatch::clear(){
+    std::fill(numbers.begin(), numbers.begin()+slots*capacity, 0);
+    size = 0;
+    slots = 0;
+}
+
+// Appends a hand, returns its index (-1 if the batch is full)
+int HandBatch::add(const Hand &h){
+    if(size==capacity){
+        return -1;
+    }
+    for(int s=0;s<h.getSize() && s<MAX_SLOTS;s++){
+        numbers[s*capacity+size] = h.getCard(s).getNumber();
+    }
+    slots = std::max(slots, std::min(h.getSize(), (int)MAX_SLOTS));
+    return size++;
+}
+
+//////////////* Evaluation *////
+
+// Whether this CPU runs kernel k
+bool HandBatch::supports(Kernel k){
+    switch(k){
+#ifdef HANDBATCH_X86
+        case SSE2: return true;
+        case AVX2: return __builtin_cpu_supports("avx2");
+#else
+        case SSE2:
+        case AVX2: return false;
+#endif
+        default: return true;
+    }
+}
+
+// Evaluates every hand with kernel k (BEST: the widest one the CPU
+// supports); hands left over from the vector width go to the scalar kernel
+void HandBatch::evaluate(Kernel k){
+    static const bool avx2 = supports(AVX2);
+    if(k==BEST){
+        k = avx2 ? AVX2 : supports(SSE2) ? SSE2 : SCALAR;
+    }
+    int done = 0;
+    if(k==AVX2 && supports(AVX2)){
+        done = evaluateAVX2();
+    }
+    else if(k==SSE2 && supports(SSE2)){
+        done = evaluateSSE2();
+    }
+    evaluateScalar(done);
+}
+
+// Reference kernel, same arithmetic as Hand::addCard()/Hand::getSum()
+void HandBatch::evaluateScalar(int from){
+    for(int i=from;i<size;i++){
+        int hard = 0, aces = 0, count = 0;
+        for(int s=0;s<slots;s++){
+            int n = numbers[s*capacity+i];
+            hard += n>10 ? 10 : n;
+            aces += n==1;
+            count += n!=0;
+        }
+        bool soft = aces>0 && hard<=11;
+        int total = soft ? hard+10 : hard;
+        totals[i] = total;
+        flags[i] = (soft ? SOFT : 0) | (total>21 ? BUST : 0) | (count==2 && total==21 ? BLACKJACK : 0);
+    }
+}
+
+#ifdef HANDBATCH_X86
+
+// 16 hands per step, returns how many hands were evaluated
+int HandBatch::evaluateSSE2(){
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i two = _mm_set1_epi8(2);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i eleven = _mm_set1_epi8(11);
+    const __m128i twentyone = _mm_set1_epi8(21);
+    const __m128i twentytwo = _mm_set1_epi8(22);
+    int i = 0;
+    for(;i+16<=size;i+=16){
+        __m128i hard = zero, aces = zero, count = zero;
+        for(int s=0;s<slots;s++){
+            __m128i n = _mm_loadu_si128((const __m128i*)&numbers[s*capacity+i]);
+            hard = _mm_add_epi8(hard, _mm_min_epu8(n, ten));
+            aces = _mm_sub_epi8(aces, _mm_cmpeq_epi8(n, one));
+            count = _mm_sub_epi8(count, _mm_andnot_si128(_mm_cmpeq_epi8(n, zero), _mm_set1_epi8(-1)));
+        }
+        __m128i soft = _mm_andnot_si128(_mm_cmpeq_epi8(aces, zero), _mm_cmpeq_epi8(_mm_min_epu8(hard, eleven), hard));
+        __m128i total = _mm_add_epi8(hard, _mm_and_si128(soft, ten));
+        __m128i bust = _mm_cmpeq_epi8(_mm_max_epu8(total, twentytwo), total);
+        __m128i natural = _mm_and_si128(_mm_cmpeq_epi8(count, two), _mm_cmpeq_epi8(total, twentyone));
+        __m128i f = _mm_or_si128(_mm_and_si128(soft, _mm_set1_epi8(SOFT)),
+                    _mm_or_si128(_mm_and_si128(bust, _mm_set1_epi8(BUST)), _mm_and_si128(natural, _mm_set1_epi8(BLACKJACK))));
+        _mm_storeu_si128((__m128i*)&totals[i], total);
+        _mm_storeu_si128((__m128i*)&flags[i], f);
+    }
+    return i;
+}
+
+// 32 hands per step, returns how many hands were evaluated
+__attribute__((target("avx2")))
+int HandBatch::evaluateAVX2(){
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i two = _mm256_set1_epi8(2);
+    const __m256i ten = _mm256_set1_epi8(10);
+    const __m256i eleven = _mm256_set1_epi8(11);
+    const __m256i twentyone = _mm256_set1_epi8(21);
+    const __m256i twentytwo = _mm256_set1_epi8(22);
+    int i = 0;
+    for(;i+32<=size;i+=32){
+        __m256i hard = zero, aces = zero, count = zero;
+        for(int s=0;s<slots;s++){
+            __m256i n = _mm256_loadu_si256((const __m256i*)&numbers[s*capacity+i]);
+            hard = _mm256_add_epi8(hard, _mm256_min_epu8(n, ten));
+            aces = _mm256_sub_epi8(aces, _mm256_cmpeq_epi8(n, one));
+            count = _mm256_sub_epi8(count, _mm256_andnot_si256(_mm256_cmpeq_epi8(n, zero), _mm256_set1_epi8(-1)));
+        }
+        __m256i soft = _mm256_andnot_si256(_mm256_cmpeq_epi8(aces, zero), _mm256_cmpeq_epi8(_mm256_min_epu8(hard, eleven), hard));
+        __m256i total = _mm256_add_epi8(hard, _mm256_and_si256(soft, ten));
+        __m256i bust = _mm256_cmpeq_epi8(_mm256_max_epu8(total, twentytwo), total);
+        __m256i natural = _mm256_and_si256(_mm256_cmpeq_epi8(count, two), _mm256_cmpeq_epi8(total, twentyone));
+        __m256i f = _mm256_or_si256(_mm256_and_si256(soft, _mm256_set1_epi8(SOFT)),
+                    _mm256_or_si256(_mm256_and_si256(bust, _mm256_set1_epi8(BUST)), _mm256_and_si256(natural, _mm256_set1_epi8(BLACKJACK))));
+        _mm256_storeu_si256((__m256i*)&totals[i], total);
+        _mm256_storeu_si256((__m256i*)&flags[i], f);
+    }
+    return i;
+}
+
+#else
+
+int HandBatch::evaluateSSE2(){
+    return 0;
+}
+
+int HandBatch::evaluateAVX2(){
+    return 0;
+}
+
+#endif
@@ -6,7 +6,7 @@
 class Banca: public Human{
 
     public:
-        void printFirstCard();
+        void printFirstCard(std::ostream &out);
 };
 
 #endif
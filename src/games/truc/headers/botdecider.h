@@ -0,0 +1,28 @@
+#ifndef BOTDECIDER_HPP
+#define BOTDECIDER_HPP
+
+#include "decider.h"
+#include "strategytable.h"
+#include "trucbot.h"
+
+// Bot seat. Blackjack decisions come from a compiled StrategyTable (flat
+// one-unit bets and drawing to 17 when it has none) for a fixed number of
+// rounds. Truc moves come from a TrucBot, or without one from the baseline:
+// heuristic cards, no bids, every bid accepted.
+class BotDecider: public Decider{
+
+    private:
+        const StrategyTable *strategy;
+        TrucBot *truc;
+        long long rounds;       // Rounds to play
+        long long played;       // Rounds played so far
+
+    public:
+        BotDecider(const StrategyTable *st, TrucBot *bot, long long n);
+        int chooseBet(int cash, int bet, int cardsLeft);
+        bool chooseHit(const Hand &player, Card up);
+        bool keepPlaying();
+        uint8_t chooseTrucMove(const TrucState &s);
+};
+
+#endif
@@ -1,30 +1,118 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// Card code: suit*16 + number, with suits in deck order
+/*
+ * 0 O: Oros;
+ * 1 E: Espases;
+ * 2 B: Bastos;
+ * 3 C: Copes;
+ */
+namespace CardTable{
+
+    constexpr int CODES = 64;
+    constexpr char SUITS[4] = {'O','E','B','C'};
+
+    // Blackjack value (aces count 11, figures 10)
+    constexpr std::array<uint8_t, CODES> makeValue(){
+        std::array<uint8_t, CODES> t{};
+        for(int c=0;c<CODES;c++){
+            int n = c&15;
+            t[c] = n==1 ? 11 : (n>10 ? 10 : n);
+        }
+        return t;
+    }
+
+    // Truc strength, higher wins the baza and equal values are parda
+    constexpr std::array<uint8_t, CODES> makeTrucRank(){
+        std::array<uint8_t, CODES> t{};
+        constexpr uint8_t byNumber[16] = {0, 7, 8, 9, 0, 1, 2, 3, 0, 0, 4, 5, 6, 0, 0, 0};
+        for(int c=0;c<CODES;c++){
+            t[c] = byNumber[c&15];
+        }
+        t[1*16+1] = 13;     // As d'espases
+        t[2*16+1] = 12;     // As de bastos
+        t[1*16+7] = 11;     // Set d'espases
+        t[0*16+7] = 10;     // Set d'oros
+        return t;
+    }
+
+    // Envit value (figures count 0)
+    constexpr std::array<uint8_t, CODES> makeEnvit(){
+        std::array<uint8_t, CODES> t{};
+        for(int c=0;c<CODES;c++){
+            int n = c&15;
+            t[c] = n<=7 ? n : 0;
+        }
+        return t;
+    }
+
+    // Hi-Lo counting tag: 2 to 6 count +1, 7 to 9 count 0, tens and aces -1
+    constexpr std::array<int8_t, CODES> makeHiLo(){
+        std::array<int8_t, CODES> t{};
+        for(int c=0;c<CODES;c++){
+            int n = c&15;
+            t[c] = (n>=2 && n<=6) ? 1 : (n>=7 && n<=9) ? 0 : -1;
+        }
+        return t;
+    }
+
+    constexpr std::array<char, CODES> makeGlyph(){
+        std::array<char, CODES> t{};
+        constexpr char byNumber[16] = {'0','A','2','3','4','5','6','7','8','9','X','J','Q','K','?','?'};
+        for(int c=0;c<CODES;c++){
+            t[c] = byNumber[c&15];
+        }
+        return t;
+    }
+
+    constexpr std::array<uint8_t, CODES> VALUE = makeValue();
+    constexpr std::array<uint8_t, CODES> TRUC_RANK = makeTrucRank();
+    constexpr std::array<uint8_t, CODES> ENVIT = makeEnvit();
+    constexpr std::array<int8_t, CODES> HI_LO = makeHiLo();
+    constexpr std::array<char, CODES> GLYPH = makeGlyph();
+    // Suit art, oros/copes/espases/bastos drawn as diamonds/hearts/spades/clubs
+    constexpr const char *ROW1[4] = {"| :/\\: |", "| :/\\: |", "| :(): |", "| (\\/) |"};
+    constexpr const char *ROW2[4] = {"| :\\/: |", "| (__) |", "| ()() |", "| :\\/: |"};
+
+}
+
+// Packed card, number and suit in a single byte
 class Card{
-    
+
     private:
-        int number; // Card Number
-        char suit;  // Card Suit
-        bool block; // Boolean value for Ace Switching
+        uint8_t code;   // Card code (suit*16 + number)
 
     public:
-        // Default Constructor
-        Card();
+        // Default Constructor (empty card)
+        constexpr Card(): code(0) {}
         // Parameterised Constructor (for initializing deck)
-        Card(int no, char s);
-        // Getter Functions    
-        int getNumber();
-        char getSuit();
-        bool getBlock();
-        // Setter Functions
-        void setNumber(int no);
-        void setSuit(char c);
-        void setBlock(bool b);
+        constexpr Card(int no, char s): code(suitIndex(s)*16+no) {}
+        // Code Conversions
+        static constexpr Card fromCode(int c){ Card r; r.code = c; return r; }
+        static constexpr int suitIndex(char s){ return s=='E' ? 1 : s=='B' ? 2 : s=='C' ? 3 : 0; }
+        constexpr int getCode() const { return code; }
+        // Getter Functions
+        constexpr int getNumber() const { return code&15; }
+        constexpr int getSuitIndex() const { return code>>4; }
+        constexpr char getSuit() const { return CardTable::SUITS[code>>4]; }
+        constexpr int getValue() const { return CardTable::VALUE[code]; }
+        constexpr int getTrucRank() const { return CardTable::TRUC_RANK[code]; }
+        constexpr int getEnvitValue() const { return CardTable::ENVIT[code]; }
+        constexpr int getHiLo() const { return CardTable::HI_LO[code]; }
+        constexpr bool operator==(Card o) const { return code==o.code; }
+        constexpr bool operator!=(Card o) const { return code!=o.code; }
         // Printing Card Details
-        char getPrintNumber();
-        void printCardL1();
-        void printCardL2();
+        constexpr char getPrintNumber() const { return CardTable::GLYPH[code]; }
+        constexpr const char* getPrintL1() const { return CardTable::ROW1[code>>4]; }
+        constexpr const char* getPrintL2() const { return CardTable::ROW2[code>>4]; }
 };
 
-#endif
\ No newline at end of file
+static_assert(sizeof(Card)==1, "Card must stay packed in one byte");
+static_assert(std::is_trivially_copyable<Card>::value, "Card is saved and copied as raw bytes");
+
+#endif
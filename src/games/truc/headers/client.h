@@ -0,0 +1,29 @@
+#ifndef CLIENT_HPP
+#define CLIENT_HPP
+
+#include "protocol.h"
+#include "screen.h"
+#include <string>
+
+// Terminal seat at a server table: sends the keys as protocol frames and
+// draws the table from the STATE replies, the way Game draws a local one.
+class Client{
+
+    private:
+        int fd;
+        std::string in;         // Bytes received, not yet a whole frame
+        Protocol::View view;    // Last state received
+        std::string name;
+        Screen screen;
+
+        bool send(uint8_t type, const std::string &payload = "");
+        void draw();
+
+    public:
+        Client();
+        ~Client();
+        bool connect(const std::string &address);
+        void play();
+};
+
+#endif
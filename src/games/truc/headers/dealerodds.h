@@ -0,0 +1,73 @@
+#ifndef DEALERODDS_HPP
+#define DEALERODDS_HPP
+
+#include "deck.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+// Cards left in a shoe, counted by blackjack value:
+// index 0 = aces, 1..8 = twos to nines, 9 = tens and figures
+struct Composition{
+
+    static const int VALUES = 10;
+    static const int MAX_DECKS = 15;    // Most the counts and getKey() can hold
+
+    uint8_t count[VALUES];
+    int total;
+
+    Composition();
+    static Composition fromDeck(Deck &d);
+    static Composition decks(int n);
+    static int valueIndex(Card c);
+    void add(int v);
+    void remove(int v);
+    uint64_t getKey() const;
+
+};
+
+// Final dealer sum: 17, 18, 19, 20, 21 or bust
+struct DealerOutcome{
+
+    static const int BUST = 5;
+
+    double p[6];
+
+    DealerOutcome();
+    double get(int sum) const;
+
+};
+
+// Exact distribution of the dealer's final sum when drawing to 17 (standing
+// on soft 17, like Rules::dealerDraws) by memoised recursion over the cards
+// left. Answers to queries are cached by (dealer cards, composition key),
+// where the key packs the counts exactly, so a repeated query is a single
+// hash lookup; the draws inside one query are not cached.
+// An instance is not thread safe, use one per thread. getInfinite() reads a
+// table, built once, of the same distribution when every draw has fixed
+// odds (an infinite shoe).
+class DealerOdds{
+
+    private:
+        struct Key{
+            uint64_t composition;
+            uint16_t state;     // hard sum and ace flag of the dealer's cards
+            bool operator==(const Key &k) const { return composition==k.composition && state==k.state; }
+        };
+        struct KeyHash{
+            size_t operator()(const Key &k) const { return (k.composition*0x9E3779B97F4A7C15ULL)^k.state; }
+        };
+        std::unordered_map<Key, DealerOutcome, KeyHash> cache;
+
+        static DealerOutcome draw(int hard, bool ace, Composition &c);
+
+    public:
+        DealerOutcome get(int upValue, const Composition &c);
+        DealerOutcome getFromHand(int hard, bool ace, const Composition &c);
+        void clear();
+        size_t getCacheSize() const;
+        static const DealerOutcome& getInfinite(int upValue);
+        static DealerOutcome getInfinite(int hard, bool ace);
+};
+
+#endif
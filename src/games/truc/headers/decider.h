@@ -0,0 +1,32 @@
+#ifndef DECIDER_HPP
+#define DECIDER_HPP
+
+#include "card.h"
+#include "hand.h"
+#include "trucstate.h"
+#include <cstdint>
+
+// Source of every decision a seated player makes, so the same game loop can
+// be played from the keyboard, from a script or by a bot. Games only draw
+// the table when the seat is human; otherwise they run at full speed.
+class Decider{
+
+    public:
+        enum BetStep{
+            BET_DONE,       // Bet placed
+            BET_RAISE,      // Add $5
+            BET_LOWER,      // Take back $5
+            BET_NONE        // Nothing (unknown key)
+        };
+
+        virtual ~Decider(){}
+        virtual bool isHuman() const { return false; }
+        // Blackjack
+        virtual int chooseBet(int cash, int bet, int cardsLeft) = 0;
+        virtual bool chooseHit(const Hand &player, Card up) = 0;
+        virtual bool keepPlaying() = 0;
+        // Truc: a legal move for the seat in s.turn
+        virtual uint8_t chooseTrucMove(const TrucState &s) = 0;
+};
+
+#endif
@@ -2,17 +2,42 @@
 #define DECK_HPP
 
 #include "card.h"
-#include <vector>
+#include "rng.h"
+#include <cstdint>
 
+// Deck stored as an occupancy mask plus an array of packed cards.
+// Every card code (suit*16+number) of either deck fits in one bit of a
+// 64-bit mask. Dealing draws a random slot among the cards still
+// left and swaps it to the end (a lazy Fisher-Yates shuffle), so both deal()
+// and initializeDeck() are O(1) apart from a 52 byte copy, and never allocate.
 class Deck{
 
+    public:
+        enum Type{
+            FRENCH,     // 52 cards, numbers 1 to 13
+            SPANISH     // 40 cards, numbers 1 to 7 and 10 to 12 (no 8 and 9)
+        };
+        static const int MAX_CARDS = 52;
+
     private:
-        std::vector<Card> deck; // Deck (Vector) of Cards
+        Type type;                  // Kind of deck
+        uint64_t present;           // Bit per card code still in the deck
+        Card order[MAX_CARDS];      // Cards, the first `left` are undealt
+        int left;                   // Cards left in the deck
+        Rng rng;                    // Random stream owned by this deck
 
     public:
+        Deck();
+        Deck(Type t);
+        void seed(uint64_t s, uint64_t table);
+        void setHand(uint64_t hand);
         void initializeDeck();
-        int getSize();
+        int getSize() const;
+        Type getType();
+        bool hasCard(Card c);
         Card deal();
+        int getCards(Card out[]);
+        void setCards(const Card in[], int n);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,41 @@
+#ifndef DOUBLEDUMMY_HPP
+#define DOUBLEDUMMY_HPP
+
+#include "trucstate.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Perfect-information (double-dummy) solver for the card play of a Truc
+// hand: with every hand face up, finds which team wins the bazas when both
+// play perfectly. Bids are left as they are, only cards are searched.
+// Alpha-beta over the winning team, so every stored result is exact. Moves
+// are ordered with TrucState::heuristicCard() first. A transposition table
+// is keyed by Zobrist hashes of the cards in each seat's hand and on the
+// table, the seat to move, the leader, the mà and the baza results, and is
+// kept between deals. An instance is not thread safe.
+class DoubleDummy{
+
+    public:
+        static const int TABLE_BITS = 16;
+
+    private:
+        struct Entry{
+            uint64_t key;
+            int8_t winner;      // -1 when empty
+        };
+        std::vector<Entry> table;
+        long long nodes;        // Positions searched by the last solve()
+
+        uint64_t hash(const TrucState &s) const;
+        int search(const TrucState &s, int alpha, int beta);
+
+    public:
+        DoubleDummy();
+        int solve(const TrucState &s, uint8_t *bestMove);
+        long long getNodes() const { return nodes; }
+        static bool parseDeal(const std::string &line, TrucState &s, std::string &error);
+        static void solveBatch(const std::vector<TrucState> &deals, std::vector<int8_t> &winners, int threads);
+};
+
+#endif
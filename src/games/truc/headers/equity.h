@@ -0,0 +1,52 @@
+#ifndef EQUITY_HPP
+#define EQUITY_HPP
+
+#include "card.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Probability that a 3-card hand wins the bazas against random hands, for
+// 1v1 and 2v2 and each seat (relative to the mà), with every seat playing
+// TrucState::heuristicCard(). The table is generated once on all cores and
+// stored as a binary file, which is loaded with a read-only shared mmap so
+// processes on the same machine share its pages and loading costs nothing.
+/*
+ * File layout (native endianness):
+ * char magic[8] = "TRUCEQ1";
+ * uint32_t hands, configs, samples, reserved;
+ * uint16_t equity[hands][configs]; (probability * 65535)
+ */
+class EquityTable{
+
+    public:
+        static const int CONFIGS = 6;   // 1v1 seats 0-1, then 2v2 seats 0-3
+
+        struct Header{
+            char magic[8];
+            uint32_t hands;
+            uint32_t configs;
+            uint32_t samples;
+            uint32_t reserved;
+        };
+
+    private:
+        void *map;                  // Whole mapped file
+        size_t mapSize;
+        const uint16_t *equity;     // Rows after the header
+
+    public:
+        EquityTable();
+        ~EquityTable();
+        EquityTable(const EquityTable&) = delete;
+        EquityTable& operator=(const EquityTable&) = delete;
+        bool load(const std::string &path);
+        void unload();
+        bool isLoaded() const { return equity!=NULL; }
+        double get(const Card cards[3], int players, int seat) const;
+        double getByIndex(int hand, int config) const { return equity[hand*CONFIGS+config]/65535.0; }
+        static int config(int players, int seat){ return players==2 ? seat : 2+seat; }
+        static bool generate(const std::string &path, int samples, int threads, uint64_t seed);
+};
+
+#endif
@@ -2,36 +2,51 @@
 #define GAME_HPP
 
 #include "deck.h"
+#include "gamerules.h"
 #include "banca.h"
 #include "player.h"
 #include "print.h"
+#include "rules.h"
+#include "screen.h"
 #include "statistics.h"
+#include "terminaldecider.h"
+#include <cstdint>
 #include <string>
 
 class Game{
 
+    public:
+        typedef ClassicBlackjack Variant;   // Rule policies of the table
+        static const int DEALER_DELAY_MS = 600; // Pause before each card the dealer draws
+
     private:
         Player player;   // Player in the game (user)
         Banca dealer;   // Dealer in the game
         Deck deck;       // Deck of cards in the game
         Statistics s;    // Leaderboard
+        uint64_t round;  // Hands played so far, selects the deck's random stream
+        TerminalDecider terminal;        // Keyboard, the default seat
+        Decider *decider;                // Seat making the player's decisions
+        bool show;                       // Draw the table (only for a human seat)
+        Screen screen;                   // Frames drawn for the human seat
 
     public:
-        Game();
-        bool dealDealer();
-        char compareSum();
-        bool checkWins();
-        char checkEnd();
+        Game(uint64_t seed);
+        void setDecider(Decider *d){ decider = d; show = d->isHuman(); }
+        void setName(std::string nm){ player.setName(nm); }
+        bool pause(int ms);
+        void showResult(char result);
         bool startBet();
-        bool startGame();
+        char playRound();
         void beginGame();
         void beginMenu(bool rep, std::string message);
         void saveGame();
-        void loadGame();
+        bool loadGame();
         void printStatistics();
         void printInstructions();
         void printTop();
         void printBody();
+        void printDealer();
 };
 
 #endif
@@ -0,0 +1,38 @@
+#ifndef GAMEENGINE_HPP
+#define GAMEENGINE_HPP
+
+#include "deck.h"
+#include "gamerules.h"
+#include <cstdint>
+
+// Round loop shared by every game, specialised at compile time by a rules
+// type from gamerules.h. Round i is dealt from a fresh deck on random stream
+// (seed, 0, i), like Simulation, so a run can be split over threads.
+template<class R>
+class GameEngine{
+
+    private:
+        Deck deck;
+        typename R::State state;
+        uint64_t round;         // Next round to play
+
+    public:
+        GameEngine(uint64_t seed): deck(R::DECK){
+            deck.seed(seed, 0);
+            round = 0;
+            R::start(state);
+        }
+        // Plays the next round with `decide` making the player's decisions
+        template<class Decide>
+        auto playRound(Decide &decide) -> decltype(R::play(state, deck, decide)){
+            deck.initializeDeck();
+            deck.setHand(round++);
+            R::deal(state, deck);
+            return R::play(state, deck, decide);
+        }
+        void setRound(uint64_t r){ round = r; }
+        uint64_t getRound() const { return round; }
+        const typename R::State& getState() const { return state; }
+};
+
+#endif
@@ -0,0 +1,209 @@
+#ifndef GAMERULES_HPP
+#define GAMERULES_HPP
+
+#include "deck.h"
+#include "hand.h"
+#include "rules.h"
+#include "strategytable.h"
+#include "trucstate.h"
+
+// Rule policies for GameEngine. Each variant is a type made of small
+// policies chosen at compile time, so the engine's round loop is inlined
+// for that variant with no virtual calls or runtime rule flags.
+/*
+ * A rules type provides:
+ *     DECK                                Deck::Type to deal from
+ *     State                               Whole state of a round
+ *     start(State&)                       Once, before the first round
+ *     deal(State&, Deck&)                 Deals a round from a shuffled deck
+ *     play(State&, Deck&, Decide&)        Plays the round to the end and
+ *                                         returns its result
+ * Blackjack also deals from anything with deal(), like a Shoe.
+ */
+
+//////////////* Blackjack Policies *////
+
+// Hand evaluator: best blackjack total, one ace counting 11 when it fits
+struct BlackjackTotal{
+    static int total(const Hand &h){ return h.getSum(); }
+};
+
+// Dealer stands on every 17 (the rule of this game)
+struct DealerS17{
+    static bool draws(const Hand &dealer){ return Rules::dealerDraws(dealer.getSum()); }
+};
+
+// Dealer hits soft 17
+struct DealerH17{
+    static bool draws(const Hand &dealer){
+        return Rules::dealerDraws(dealer.getSum()) || (dealer.getSum()==Rules::DEALER_STANDS && dealer.isSoft());
+    }
+};
+
+// Player policy: hits while below a fixed total
+struct HitBelow{
+    int total;
+    bool operator()(const Hand &player, Card up) const { return player.getSum()<total; }
+};
+
+// Player policy: a compiled StrategyTable (standing where it has no rule),
+// or without one hitting below a fixed total
+struct ChartOrHitBelow{
+    const StrategyTable *chart;
+    int total;
+    bool operator()(const Hand &player, Card up) const {
+        if(chart==NULL){
+            return player.getSum()<total;
+        }
+        int v = up.getValue();
+        return chart->decide(StrategyTable::playKey(player.getSum(), player.isSoft(), v==11 ? 1 : v))=='H';
+    }
+};
+
+// Dealer watcher that does nothing (see Blackjack::stand)
+struct NoWatch{
+    void operator()(const Hand &dealer) const {}
+};
+
+// Blackjack round: 2 cards each, the player hits while decide(player, up)
+// says so, then the dealer plays. Scoring provides checkEnd, compareSum,
+// dealerPlays and payout like Rules (the house rules of this game).
+// The round is made of steps, deal(), hit() and stand(), which play()
+// chains for a decider answering at once. Game plays the whole round
+// through play(); Table, whose seat answers later, takes the same steps one
+// action at a time. Every step works on State or on Hands, the hands of a
+// round kept elsewhere (Game's Player and Banca).
+template<Deck::Type DECK_TYPE, class Evaluator, class Dealer, class Scoring>
+struct Blackjack{
+
+    typedef Evaluator EvaluatorPolicy;
+    typedef Dealer DealerPolicy;
+    typedef Scoring ScoringPolicy;
+
+    static const Deck::Type DECK = DECK_TYPE;
+
+    struct State{
+        Hand player;
+        Hand dealer;
+    };
+
+    struct Hands{
+        Hand &player;
+        Hand &dealer;
+    };
+
+    static void start(State &s){}
+
+    template<class S, class Source>
+    static void deal(S &s, Source &deck){
+        s.player.clearCards();
+        s.dealer.clearCards();
+        s.player.addCard(deck.deal());
+        s.dealer.addCard(deck.deal());
+        s.player.addCard(deck.deal());
+        s.dealer.addCard(deck.deal());
+    }
+
+    // 'p', 'd' or 'n' once a bust or a 21 ends the round, else 'f'
+    template<class S>
+    static char checkEnd(const S &s){
+        return Scoring::checkEnd(Evaluator::total(s.dealer), Evaluator::total(s.player));
+    }
+
+    // The player takes a card
+    template<class S, class Source>
+    static char hit(S &s, Source &deck){
+        s.player.addCard(deck.deal());
+        return checkEnd(s);
+    }
+
+    // The player stands and the dealer plays out its hand, calling
+    // watch(dealer) before each card it draws. Returns the result.
+    template<class S, class Source, class Watch>
+    static char stand(S &s, Source &deck, Watch &watch){
+        if(Scoring::dealerPlays(Evaluator::total(s.dealer), Evaluator::total(s.player))){
+            while(Dealer::draws(s.dealer)){
+                watch(s.dealer);
+                s.dealer.addCard(deck.deal());
+                char result = checkEnd(s);
+                if(result!='f'){
+                    return result;
+                }
+            }
+        }
+        return Scoring::compareSum(Evaluator::total(s.dealer), Evaluator::total(s.player));
+    }
+
+    template<class S, class Source>
+    static char stand(S &s, Source &deck){
+        NoWatch watch;
+        return stand(s, deck, watch);
+    }
+
+    // Result of the round: 'p', 'd' or 'n'
+    template<class S, class Source, class Decide, class Watch>
+    static char play(S &s, Source &deck, Decide &decide, Watch &watch){
+        char result = checkEnd(s);
+        while(result=='f' && decide(s.player, s.dealer.getCard(0))){
+            result = hit(s, deck);
+        }
+        return result=='f' ? stand(s, deck, watch) : result;
+    }
+
+    template<class S, class Source, class Decide>
+    static char play(S &s, Source &deck, Decide &decide){
+        NoWatch watch;
+        return play(s, deck, decide, watch);
+    }
+
+};
+
+typedef Blackjack<Deck::FRENCH, BlackjackTotal, DealerS17, Rules> ClassicBlackjack;
+typedef Blackjack<Deck::FRENCH, BlackjackTotal, DealerH17, Rules> ClassicBlackjackH17;
+
+//////////////* Truc Policies *////
+
+// Truc hand for PLAYERS seats and a game to TARGET points. The mà moves one
+// seat each hand and a new game starts when one ends. decide(state) returns
+// the move of the seat in state.turn.
+template<int PLAYERS, int TARGET>
+struct Truc{
+
+    static const Deck::Type DECK = Deck::SPANISH;
+
+    typedef TrucState State;
+
+    static void start(State &s){
+        s.newGame(PLAYERS, TARGET);
+        s.mano = PLAYERS-1;
+    }
+
+    static void deal(State &s, Deck &deck){
+        if(s.isGameOver()){
+            start(s);
+        }
+        s.dealHand(deck, (s.mano+1)%PLAYERS);
+    }
+
+    // Points of team 0 minus points of team 1 in the hand
+    template<class Decide>
+    static int play(State &s, Deck &deck, Decide &decide){
+        while(!s.isHandOver()){
+            s.apply(decide(s));
+        }
+        return s.handPoints[0]-s.handPoints[1];
+    }
+
+};
+
+// Player policy: heuristic cards, no bids, every bid accepted
+struct TrucBaseline{
+    uint8_t operator()(const TrucState &s) const {
+        return s.phase==TrucState::RESPOND ? (uint8_t)TrucState::ACCEPT : (uint8_t)s.heuristicCard();
+    }
+};
+
+typedef Truc<2, 24> TrucHeadsUp;
+typedef Truc<4, 24> TrucTeams;
+
+#endif
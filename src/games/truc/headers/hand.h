@@ -0,0 +1,46 @@
+#ifndef HAND_HPP
+#define HAND_HPP
+
+#include "card.h"
+#include <cstdint>
+
+// Hand with an incremental blackjack evaluator. Cards live in a fixed inline
+// buffer sized for the longest hand an 8-deck shoe allows (20 aces then a
+// last card; a hand stops at 21 and Truc hands are 3) and the totals are
+// updated on addCard(), so getSum() is O(1).
+class Hand{
+
+    public:
+        static const int MAX_CARDS = 21;
+
+    protected:
+        Card cards[MAX_CARDS];      // Cards held
+        uint8_t count;              // Number of cards held
+        uint8_t hard;               // Sum counting every ace as 1
+        uint8_t aces;               // Number of aces held
+
+    public:
+        Hand(): count(0), hard(0), aces(0) {}
+        // Best sum, one ace counts 11 when that doesn't bust the hand
+        int getSum() const { return isSoft() ? hard+10 : hard; }
+        int getHard() const { return hard; }
+        bool isSoft() const { return aces>0 && hard<=11; }
+        int getSize() const { return count; }
+        Card getCard(int i) const { return cards[i]; }
+        // Adds card to the hand (cards beyond MAX_CARDS still count in the sums)
+        void addCard(Card c){
+            if(count<MAX_CARDS){
+                cards[count] = c;
+            }
+            count++;
+            hard += c.getNumber()>10 ? 10 : c.getNumber();
+            aces += c.getNumber()==1;
+        }
+        void clearCards(){
+            count = 0;
+            hard = 0;
+            aces = 0;
+        }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef HANDBATCH_HPP
+#define HANDBATCH_HPP
+
+#include "hand.h"
+#include <cstdint>
+#include <vector>
+
+// Many blackjack hands evaluated at once. Card numbers are stored in
+// structure-of-arrays layout (slot-major: every hand's first card, then every
+// hand's second card...) with 0 for empty slots, so the kernels process 16
+// (SSE2) or 32 (AVX2) hands per instruction. Results match Hand::getSum() and
+// Hand::isSoft() exactly.
+class HandBatch{
+
+    public:
+        static const int MAX_SLOTS = Hand::MAX_CARDS;
+        static const int LANES = 32;    // Capacity is padded to this many hands
+        // Flag bits
+        static const uint8_t SOFT = 1;      // An ace counts 11
+        static const uint8_t BUST = 2;      // Total over 21
+        static const uint8_t BLACKJACK = 4; // Natural: two cards totalling 21
+        enum Kernel{ BEST, SCALAR, SSE2, AVX2 };
+
+    private:
+        int size;                       // Hands in the batch
+        int capacity;                   // Allocated hands (multiple of LANES)
+        int slots;                      // Rows holding a card (the rest are 0)
+        std::vector<uint8_t> numbers;   // MAX_SLOTS rows of `capacity` numbers
+        std::vector<uint8_t> totals;    // Best sum per hand
+        std::vector<uint8_t> flags;     // SOFT | BUST | BLACKJACK per hand
+
+        void evaluateScalar(int from);
+        int evaluateSSE2();
+        int evaluateAVX2();
+
+    public:
+        HandBatch(int n);
+        void clear();
+        int add(const Hand &h);
+        // Sets one card of a hand directly (hands must be filled from slot 0)
+        void setCard(int hand, int slot, Card c){
+            numbers[slot*capacity+hand] = c.getNumber();
+            slots = slot>=slots ? slot+1 : slots;
+            size = hand>=size ? hand+1 : size;
+        }
+        void evaluate(Kernel k=BEST);
+        static bool supports(Kernel k);
+        int getSize() const { return size; }
+        int getTotal(int i) const { return totals[i]; }
+        uint8_t getFlags(int i) const { return flags[i]; }
+        bool isSoft(int i) const { return flags[i]&SOFT; }
+        bool isBust(int i) const { return flags[i]&BUST; }
+        bool isBlackjack(int i) const { return flags[i]&BLACKJACK; }
+};
+
+#endif
@@ -1,22 +1,16 @@
 #ifndef HUMAN_HPP
 #define HUMAN_HPP
 
-#include "card.h"
-#include <vector>
+#include "hand.h"
+#include <ostream>
+#include <string>
 
-class Human{
-
-    protected:
-        std::vector<Card> hand;
-        int sum;
+class Human: public Hand{
 
     public:
-        Human();
-        int getSum();
-        void switchAce();
-        void addCard(Card c);
-        void clearCards();
-        void printCards();
+        static const int CARD_ROWS = 6;
+        static const std::string& cardRow(Card c, int row);
+        void printCards(std::ostream &out);
 };
 
-#endif
\ No newline at end of file
+#endif
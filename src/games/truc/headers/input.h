@@ -0,0 +1,54 @@
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keyboard of the session. The terminal is put into raw mode (no echo, no
+// line buffering) once, on first use, and restored at exit or on a fatal
+// signal. Keys are read in batches with poll() and queued, and timers are
+// served from the same wait, so a loop can react to whichever comes first.
+class Input{
+
+    public:
+        enum EventType{ KEY, TIMER, NONE };
+
+        struct Event{
+            EventType type;
+            int key;       // Byte read, for KEY
+            int timer;     // Id returned by addTimer, for TIMER
+        };
+
+    private:
+        struct Timer{
+            int id;
+            int64_t deadline;   // Monotonic milliseconds
+        };
+
+        std::string keys;             // Read but not yet delivered
+        size_t next;                  // First undelivered key
+        std::vector<Timer> timers;
+        int nextTimer;
+        bool started;                 // Terminal already set up
+        bool closed;                  // Input reached end of file
+
+        Input();
+        void enter();
+        bool fill(int timeoutMs);
+        static int64_t now();
+
+    public:
+        static Input& session();
+        static void restore();
+
+        bool wait(Event &e, int timeoutMs);
+        int key();
+        std::string word();
+        char answer();
+
+        int addTimer(int ms);
+        void cancelTimer(int id);
+};
+
+#endif
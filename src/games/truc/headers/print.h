@@ -5,17 +5,17 @@
 
 struct Print{
 
-    static std::string title_blackjack();
-    static std::string begin_menu();
-    static std::string statistics();
-    static std::string instructions();
-    static std::string bust();
-    static std::string blackjack();
-    static std::string dealer_wins();
-    static std::string you_win();
-    static std::string draw();
-    static std::string dealer_border();
-    static std::string player_border();
+    static const std::string& title_blackjack();
+    static const std::string& begin_menu();
+    static const std::string& statistics();
+    static const std::string& instructions();
+    static const std::string& bust();
+    static const std::string& blackjack();
+    static const std::string& dealer_wins();
+    static const std::string& you_win();
+    static const std::string& draw();
+    static const std::string& dealer_border();
+    static const std::string& player_border();
 
 };
 
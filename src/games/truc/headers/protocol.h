@@ -0,0 +1,137 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include "hand.h"
+#include "table.h"
+#include <cstdint>
+#include <string>
+
+// Wire format between table clients and the server. Every message is a
+// frame [length][type][payload], the length byte counting type and payload,
+// and integers are little endian. Each client frame is answered by exactly
+// one STATE frame; actions that aren't legal leave the table unchanged.
+/*
+ * Client frames:
+ *     JOIN name   RAISE   LOWER   DEAL   HIT   STAND   NEXT   LEAVE
+ * Server frames:
+ *     STATE phase, result, cash(4), bet(4), wins(4), loses(4),
+ *           player cards (count + codes), dealer cards (count + codes)
+ * While the round is being played only the dealer's first card is sent.
+ */
+struct Protocol{
+
+    enum Type{
+        JOIN = 1,
+        RAISE,
+        LOWER,
+        DEAL,
+        HIT,
+        STAND,
+        NEXT,
+        LEAVE,
+        STATE = 0x80
+    };
+    static const int MAX_FRAME = 256;   // Length byte + at most 255 bytes
+    static const int MAX_NAME = 32;
+
+    // Table as seen by the client
+    struct View{
+        uint8_t phase;
+        char result;
+        int32_t cash, bet;
+        int32_t wins, loses;
+        Hand player;
+        Hand dealer;
+    };
+
+    static void frame(std::string &out, uint8_t type, const char *payload = "", int n = 0);
+    static void state(std::string &out, const Table &t);
+    static int frameSize(const std::string &in, size_t at);
+    static bool readState(const uint8_t *p, int n, View &v);
+
+    static void put32(std::string &out, int32_t v){
+        for(int i=0;i<4;i++){
+            out.push_back((char)(v>>(8*i)));
+        }
+    }
+    static int32_t get32(const uint8_t *p){
+        return (int32_t)(p[0] | p[1]<<8 | p[2]<<16 | (uint32_t)p[3]<<24);
+    }
+
+};
+
+//////////////* Writing *////
+
+inline void Protocol::frame(std::string &out, uint8_t type, const char *payload, int n){
+    out.push_back((char)(n+1));
+    out.push_back((char)type);
+    out.append(payload, n);
+}
+
+inline void Protocol::state(std::string &out, const Table &t){
+    size_t start = out.size();
+    out.push_back(0);
+    out.push_back((char)STATE);
+    out.push_back((char)t.getPhase());
+    out.push_back(t.getResult());
+    put32(out, t.getCash());
+    put32(out, t.getBet());
+    put32(out, t.getWins());
+    put32(out, t.getLoses());
+    const Hand &p = t.getPlayer();
+    int n = p.getSize()<Hand::MAX_CARDS ? p.getSize() : Hand::MAX_CARDS;
+    out.push_back((char)n);
+    for(int i=0;i<n;i++){
+        out.push_back((char)p.getCard(i).getCode());
+    }
+    const Hand &d = t.getDealer();
+    n = t.getPhase()==Table::PLAYING ? 1 : d.getSize()<Hand::MAX_CARDS ? d.getSize() : Hand::MAX_CARDS;
+    out.push_back((char)n);
+    for(int i=0;i<n;i++){
+        out.push_back((char)d.getCard(i).getCode());
+    }
+    out[start] = (char)(out.size()-start-1);
+}
+
+//////////////* Reading *////
+
+// Bytes of the whole frame starting at `at`, or 0 while it's incomplete.
+// A frame always has a type byte, so a length of 0 is malformed: -1.
+inline int Protocol::frameSize(const std::string &in, size_t at){
+    if(at>=in.size()){
+        return 0;
+    }
+    if(in[at]==0){
+        return -1;
+    }
+    int n = 1+(uint8_t)in[at];
+    return at+n<=in.size() ? n : 0;
+}
+
+// Decodes a STATE payload (after the type byte)
+inline bool Protocol::readState(const uint8_t *p, int n, View &v){
+    if(n<20){
+        return false;
+    }
+    v.phase = p[0];
+    v.result = p[1];
+    v.cash = get32(p+2);
+    v.bet = get32(p+6);
+    v.wins = get32(p+10);
+    v.loses = get32(p+14);
+    int at = 18;
+    Hand *hands[2] = {&v.player, &v.dealer};
+    for(int h=0;h<2;h++){
+        if(at>=n || at+1+p[at]>n){
+            return false;
+        }
+        hands[h]->clearCards();
+        for(int i=0;i<p[at];i++){
+            hands[h]->addCard(Card::fromCode(p[at+1+i]));
+        }
+        at += 1+p[at];
+    }
+    return true;
+}
+
+#endif
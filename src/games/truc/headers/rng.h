@@ -0,0 +1,33 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+
+// Counter-based random generator (Philox4x32-10, Salmon et al. 2011).
+// Every output is a pure function of (seed, table, hand, block), so any
+// table can jump straight to any hand without generating the ones before,
+// and threads never share state. The 128-bit counter is laid out as
+// {block, hand low, hand high, table} and the 64-bit key is the seed.
+class Rng{
+
+    private:
+        uint32_t key[2];        // Seed
+        uint32_t counter[4];    // Block, hand (2 words), table
+        uint32_t out[4];        // Current output block
+        int used;               // Words of `out` already handed out
+
+        void refill();
+
+    public:
+        Rng();
+        Rng(uint64_t seed, uint64_t table);
+        void setSeed(uint64_t seed, uint64_t table);
+        void setHand(uint64_t hand);
+        void jump(uint64_t blocks);
+        uint32_t next();
+        uint32_t below(uint32_t n);
+        double uniform();
+        static void philox(const uint32_t ctr[4], const uint32_t k[2], uint32_t result[4]);
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef RULES_HPP
+#define RULES_HPP
+
+// Blackjack rules without any input/output, shared by the interactive Game
+// and the headless Simulation. Defined inline so hot loops can fold them in.
+/*
+ * Results:
+ * 'p': Player wins;
+ * 'd': Dealer wins;
+ * 'n': Push (draw);
+ * 'f': Not finished yet;
+ */
+struct Rules{
+
+    static const int DEALER_STANDS = 17;   // Dealer stops drawing at this sum
+    static const int BLACKJACK = 21;
+
+    static char checkEnd(int dealerSum, int playerSum);
+    static char compareSum(int dealerSum, int playerSum);
+    static bool dealerPlays(int dealerSum, int playerSum);
+    static bool dealerDraws(int dealerSum);
+    static int payout(char result, int bet);
+
+};
+
+//////////////* Checkers *////
+
+// Checks for a bust or a 21 on either side (dealer wins ties at 21)
+inline char Rules::checkEnd(int dealerSum, int playerSum){
+    if(dealerSum>BLACKJACK || playerSum>BLACKJACK){
+        if(dealerSum>BLACKJACK){
+            return 'p';
+        }
+        return 'd';
+    }
+    else if(dealerSum==BLACKJACK || playerSum==BLACKJACK){
+        if(dealerSum==BLACKJACK){
+            return 'd';
+        }
+        return 'p';
+    }
+    return 'f';
+}
+
+// Compares both sums once the dealer has finished
+inline char Rules::compareSum(int dealerSum, int playerSum){
+    if(playerSum>dealerSum){
+        return 'p';
+    }
+    else if(dealerSum>playerSum){
+        return 'd';
+    }
+    return 'n';
+}
+
+//////////////* Dealer Policy *////
+
+// The dealer only draws when the player is ahead after standing
+inline bool Rules::dealerPlays(int dealerSum, int playerSum){
+    return dealerSum<playerSum;
+}
+
+// Once playing, the dealer draws until reaching DEALER_STANDS
+inline bool Rules::dealerDraws(int dealerSum){
+    return dealerSum<DEALER_STANDS;
+}
+
+//////////////* Payout *////
+
+// Cash returned to the player for a finished round (bet was already taken)
+inline int Rules::payout(char result, int bet){
+    switch(result){
+        case 'p': return bet*2;
+        case 'n': return bet;
+    }
+    return 0;
+}
+
+#endif
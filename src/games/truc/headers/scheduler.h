@@ -0,0 +1,166 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "task.h"
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Single-threaded scheduler for coroutine tables: a queue of coroutines
+// ready to resume plus one-shot timers. It never blocks by itself, so it
+// can run alone (run()) or inside another event loop, which waits for at
+// most nextTimeout() and then calls runReady() and fireTimers(). A thread
+// owns each scheduler; nothing in it is locked.
+class Scheduler{
+
+    public:
+        // Told when one of its timers expires
+        class Waker{
+            public:
+                virtual ~Waker(){}
+                virtual void expire(uint64_t id) = 0;
+        };
+
+    private:
+        struct Timer{
+            int64_t deadline;   // Monotonic milliseconds
+            uint64_t id;
+            bool operator>(const Timer &o) const { return deadline>o.deadline; }
+        };
+
+        std::deque<std::coroutine_handle<>> ready;
+        std::vector<Timer> timers;                      // Min-heap on the deadline
+        std::unordered_map<uint64_t, Waker*> armed;     // Timers not expired or cancelled
+        uint64_t nextTimer;
+
+        void compact();
+
+    public:
+        Scheduler(): nextTimer(0) {}
+        static int64_t now();
+
+        void post(std::coroutine_handle<> h){ ready.push_back(h); }
+        void start(const Task<void> &t){ post(t.getHandle()); }
+        uint64_t addTimer(int ms, Waker *w);
+        void cancelTimer(uint64_t id);
+
+        long long runReady();
+        int fireTimers();
+        int nextTimeout() const;
+        bool isIdle() const { return ready.empty() && armed.empty(); }
+        void run();
+
+        // co_await yield(): lets every other ready coroutine run first
+        struct Yield{
+            Scheduler *s;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h){ s->post(h); }
+            void await_resume() const noexcept {}
+        };
+        Yield yield(){ return Yield{this}; }
+
+        // co_await sleep(ms)
+        class Sleep: public Waker{
+            private:
+                Scheduler *s;
+                int ms;
+                uint64_t timer;
+                bool pending;
+                std::coroutine_handle<> h;
+            public:
+                Sleep(Scheduler *sc, int m): s(sc), ms(m), timer(0), pending(false) {}
+                ~Sleep(){
+                    if(pending){
+                        s->cancelTimer(timer);
+                    }
+                }
+                bool await_ready() const noexcept { return ms<=0; }
+                void await_suspend(std::coroutine_handle<> c){
+                    h = c;
+                    timer = s->addTimer(ms, this);
+                    pending = true;
+                }
+                void await_resume() const noexcept {}
+                void expire(uint64_t id){
+                    pending = false;
+                    s->post(h);
+                }
+        };
+        Sleep sleep(int ms){ return Sleep(this, ms); }
+};
+
+// Value a coroutine waits for, like a player's next action. resolve() hands
+// it over: the waiting coroutine is queued on its scheduler, or the value is
+// kept until someone awaits it. within() waits with a deadline and yields
+// `fallback` when it passes first.
+template<class T>
+class Decision{
+
+    private:
+        Scheduler *scheduler;
+        std::coroutine_handle<> waiting;
+        T value;
+        bool ready;
+
+    public:
+        Decision(): scheduler(NULL), waiting(nullptr), value(), ready(false) {}
+        bool isWaiting() const { return (bool)waiting; }
+        void resolve(T v){
+            value = v;
+            ready = true;
+            if(waiting){
+                std::coroutine_handle<> h = waiting;
+                waiting = nullptr;
+                scheduler->post(h);
+            }
+        }
+
+        class Awaiter: public Scheduler::Waker{
+            private:
+                Decision *d;
+                Scheduler *s;
+                int ms;
+                T fallback;
+                uint64_t timer;
+                bool pending;       // Timer armed
+            public:
+                Awaiter(Decision *dc, Scheduler *sc, int m, T f): d(dc), s(sc), ms(m), fallback(f), timer(0), pending(false) {}
+                // The frame can be destroyed while waiting: forget it
+                ~Awaiter(){
+                    if(pending){
+                        s->cancelTimer(timer);
+                    }
+                    if(d->waiting){
+                        d->waiting = nullptr;
+                    }
+                }
+                bool await_ready() const noexcept { return d->ready; }
+                void await_suspend(std::coroutine_handle<> h){
+                    d->waiting = h;
+                    d->scheduler = s;
+                    if(ms>0){
+                        timer = s->addTimer(ms, this);
+                        pending = true;
+                    }
+                }
+                T await_resume(){
+                    if(pending){
+                        s->cancelTimer(timer);
+                        pending = false;
+                    }
+                    d->ready = false;
+                    return d->value;
+                }
+                void expire(uint64_t id){
+                    pending = false;
+                    d->resolve(fallback);
+                }
+        };
+        // ms <= 0 waits without a deadline
+        Awaiter within(Scheduler &s, int ms, T fallback){ return Awaiter(this, &s, ms, fallback); }
+};
+
+#endif
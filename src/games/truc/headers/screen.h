@@ -0,0 +1,54 @@
+#ifndef SCREEN_HPP
+#define SCREEN_HPP
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Frame renderer for the terminal. A frame is composed into a reusable
+// buffer through out(), then present() sends it with a single write():
+// only the rows that changed since the last frame are redrawn, each one
+// placed with ANSI cursor positioning, and the cursor is left at the end of
+// the last row for the prompt. Frames taller than the terminal, or after
+// invalidate(), are redrawn whole.
+class Screen{
+
+    private:
+        // Appends everything streamed to the frame buffer
+        class FrameBuffer: public std::streambuf{
+            public:
+                std::string *frame;
+            protected:
+                int overflow(int c){
+                    if(c!=EOF){
+                        frame->push_back((char)c);
+                    }
+                    return c;
+                }
+                std::streamsize xsputn(const char *s, std::streamsize n){
+                    frame->append(s, n);
+                    return n;
+                }
+        };
+
+        std::string frame;                  // Frame being composed
+        std::string output;                 // Bytes sent by the last present()
+        std::vector<std::string> rows;      // Rows of the frame, with their starting colour
+        std::vector<std::string> previous;  // Rows on the terminal
+        FrameBuffer buffer;
+        std::ostream stream;
+        bool full;                          // Next frame redraws everything
+
+        void split();
+        static int height();
+
+    public:
+        Screen();
+        std::ostream& begin();
+        std::ostream& out(){ return stream; }
+        void present();
+        void invalidate(){ full = true; }
+};
+
+#endif
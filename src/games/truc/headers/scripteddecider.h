@@ -0,0 +1,36 @@
+#ifndef SCRIPTEDDECIDER_HPP
+#define SCRIPTEDDECIDER_HPP
+
+#include "decider.h"
+#include <string>
+#include <vector>
+
+// Replays decisions from a text file, for regression replays and load
+// tests. Tokens are read in order ('#' starts a comment):
+//     5, 10, ...                  Bet in dollars (rounded down to $5)
+//     H / S                       Hit or stand
+//     Y / N                       Keep playing or stop
+//     1 2 3 truc envit falta vull novull     Truc move
+// A token that doesn't fit the decision asked for ends the script, and from
+// then on the seat stands, stops playing and makes the first legal move.
+class ScriptedDecider: public Decider{
+
+    private:
+        std::vector<std::string> tokens;
+        size_t next;            // Next token to use
+        int betTarget;          // Bet being placed, -1 when none
+
+        bool take(std::string &token);
+        bool stop();
+
+    public:
+        ScriptedDecider();
+        bool load(const std::string &path);
+        bool isFinished() const { return next>=tokens.size(); }
+        int chooseBet(int cash, int bet, int cardsLeft);
+        bool chooseHit(const Hand &player, Card up);
+        bool keepPlaying();
+        uint8_t chooseTrucMove(const TrucState &s);
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef SEAT_HPP
+#define SEAT_HPP
+
+#include "decider.h"
+#include "scheduler.h"
+#include "table.h"
+
+// Player at a coroutine table. The table calls ask() and then awaits
+// `action`: a remote player resolves it when their message arrives, a bot
+// straight away from ask().
+class Seat{
+
+    public:
+        Decision<int> action;   // Next Table::Action
+
+        virtual ~Seat(){}
+        virtual void ask(const Table &t){}
+};
+
+// Seat played by a Decider (bots and scripts)
+class DeciderSeat: public Seat{
+
+    private:
+        Decider *decider;
+
+    public:
+        DeciderSeat(Decider *d): decider(d) {}
+        void ask(const Table &t);
+};
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef SELFTEST_HPP
+#define SELFTEST_HPP
+
+#include <cstdint>
+#include <ostream>
+
+// Checks of the fast paths and the solver against the simple code they
+// must agree with, and of inputs that once broke the server, run by
+// `truc --selftest` (and ctest). Each check prints one line and returns whether it passed.
+namespace SelfTest{
+
+    bool handBatch(std::ostream &out, uint64_t seed);
+    bool solverExact(std::ostream &out);
+    bool serverFrames(std::ostream &out, uint64_t seed);
+    // Every check, 0 when all of them pass
+    int run(std::ostream &out, uint64_t seed);
+
+}
+
+#endif
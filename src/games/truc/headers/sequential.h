@@ -0,0 +1,122 @@
+#ifndef SEQUENTIAL_HPP
+#define SEQUENTIAL_HPP
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Running mean and variance (Welford 1962). Two accumulators of separate
+// samples merge into the one of all of them (Chan et al. 1979), so every
+// worker keeps its own and they are added up afterwards.
+struct Welford{
+
+    long long n;
+    double mean;
+    double m2;          // Sum of squared deviations from the mean
+
+    Welford();
+    Welford(long long count, double sum, double sumSq);
+    void add(double x);
+    void merge(const Welford &w);
+    double getVariance() const;
+    double getStdError() const;
+
+};
+
+// When a run of samples may stop: once the 95 % interval of the mean is
+// narrower than +/- a half-width, or once a sequential probability ratio
+// test (Wald 1945) decides between mean m0 and mean m1. The SPRT takes the
+// samples as normal with the variance seen so far, like engine testers do,
+// so nothing is decided before MIN_SAMPLES.
+class StoppingRule{
+
+    public:
+        enum Verdict{ CONTINUE, PRECISE, ACCEPT_M0, ACCEPT_M1 };
+        static const long long MIN_SAMPLES = 100;
+
+    private:
+        double halfWidth;       // 0 when unused
+        bool sprt;
+        double m0, m1;
+        double lower, upper;    // Log-likelihood ratio bounds
+
+    public:
+        StoppingRule();
+        void setPrecision(double h);
+        void setSprt(double mean0, double mean1, double alpha, double beta);
+        bool isActive() const { return halfWidth>0 || sprt; }
+        bool isSprt() const { return sprt; }
+        double getM0() const { return m0; }
+        double getM1() const { return m1; }
+        double getLlr(const Welford &w) const;
+        Verdict check(const Welford &w) const;
+};
+
+// Plays chunks 0..chunks-1 on `threads` workers and folds their results in
+// chunk order until fold() returns true; returns the chunks folded. Results
+// go through a ring of 2*threads slots: a worker takes the next chunk from
+// an atomic counter, waits until the chunk that held its slot was folded,
+// and publishes the chunk's index in the slot with a release store. Nothing
+// is locked, memory doesn't grow with the budget, and the chunks folded
+// don't depend on the number of threads. Chunks past the stop are dropped.
+template<class Result, class Play, class Fold>
+long long runChunks(long long chunks, int threads, Play play, Fold fold){
+    const long long slots = 2*(long long)(threads>0 ? threads : 1);
+    std::vector<Result> results(slots);
+    std::unique_ptr<std::atomic<long long>[]> ready(new std::atomic<long long>[slots]);
+    for(long long s=0;s<slots;s++){
+        ready[s].store(-1, std::memory_order_relaxed);
+    }
+    std::atomic<long long> next(0);
+    std::atomic<long long> folded(0);       // Chunks folded, frees their slots
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> workers;
+    for(int t=0;t<threads;t++){
+        workers.emplace_back([&](){
+            while(!stop.load(std::memory_order_relaxed)){
+                long long c = next.fetch_add(1);
+                if(c>=chunks){
+                    break;
+                }
+                long long f = folded.load(std::memory_order_acquire);
+                while(c-f>=slots && !stop.load(std::memory_order_relaxed)){
+                    folded.wait(f, std::memory_order_acquire);
+                    f = folded.load(std::memory_order_acquire);
+                }
+                if(stop.load(std::memory_order_relaxed)){
+                    break;
+                }
+                Result &r = results[c%slots];
+                r = Result();
+                play(c, r);
+                ready[c%slots].store(c, std::memory_order_release);
+                ready[c%slots].notify_one();
+            }
+        });
+    }
+    long long done = 0;
+    while(done<chunks){
+        std::atomic<long long> &slot = ready[done%slots];
+        for(long long c=slot.load(std::memory_order_acquire);c!=done;c=slot.load(std::memory_order_acquire)){
+            slot.wait(c, std::memory_order_acquire);
+        }
+        bool enough = fold(results[done%slots]);
+        done++;
+        if(enough){
+            break;
+        }
+        folded.store(done, std::memory_order_release);
+        folded.notify_all();
+    }
+    // Wakes the workers waiting for a slot
+    stop = true;
+    folded.store(chunks, std::memory_order_release);
+    folded.notify_all();
+    for(std::thread &w: workers){
+        w.join();
+    }
+    return done;
+}
+
+#endif
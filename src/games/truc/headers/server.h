@@ -0,0 +1,83 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include "scheduler.h"
+#include "seat.h"
+#include "table.h"
+#include "task.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Table server. Each connection is a session owning its own Table, and
+// sessions are sharded over worker threads: every worker runs its own epoll
+// loop and accepts from the shared listening socket (EPOLLEXCLUSIVE wakes
+// one worker per connection), then keeps the session for its whole life, so
+// no lock is taken after start up. Clients speak the frames of protocol.h.
+// Each table is played by Table::play(), a coroutine on its worker's
+// scheduler that the frames received resume; a player idle for longer than
+// the idle time is stood, or let go between rounds.
+/*
+ * Addresses:
+ *     unix:PATH     Unix socket (the file is replaced)
+ *     HOST:PORT     TCP on that interface
+ *     PORT          TCP on every interface
+ */
+class Server{
+
+    private:
+        static const size_t MAX_PENDING = 1<<16;   // Unsent bytes before a client is dropped
+
+        struct Session{
+            int fd;
+            Table table;
+            Seat seat;              // Resolved by the frames received
+            Task<void> game;        // Table::play(), destroyed before the seat
+            std::string in;         // Bytes received, not yet a whole frame
+            std::string out;        // Replies the socket didn't take yet
+            bool writing;           // Waiting for EPOLLOUT
+            bool closing;           // Client is done sending: close once the replies are out
+            Session(int f, uint64_t seed, uint64_t id): fd(f), table(seed, id), writing(false), closing(false) {}
+        };
+
+        struct Worker{
+            int epoll;
+            int wake;                   // eventfd, written by stop()
+            uint64_t nextId;            // Table id of the next session
+            long long sessions;         // Sessions accepted
+            long long requests;         // Frames handled
+            std::vector<Session*> open; // Sessions by fd
+            std::vector<Session*> idle; // Let go by their table, to close
+            Scheduler scheduler;        // Tables of this worker
+            std::thread thread;
+        };
+
+        int listener;
+        std::string unixPath;
+        uint64_t seed;
+        int idleMs;                     // Idle time before playing for a player (0 = never)
+        std::vector<Worker> workers;
+
+        Task<void> host(Worker &w, Session *s);
+        void runWorker(Worker &w);
+        void accept(Worker &w);
+        bool receive(Worker &w, Session &s);
+        bool flush(Worker &w, Session &s);
+        void close(Worker &w, Session *s);
+
+    public:
+        Server(uint64_t s, int idle);
+        ~Server();
+        bool listen(const std::string &address);
+        void run(int threads);
+        void stop();
+        long long getSessions() const;
+        long long getRequests() const;
+
+        static int connect(const std::string &address);
+        static long long bench(const std::string &address, int clients, long long rounds);
+};
+
+#endif
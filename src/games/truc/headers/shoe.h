@@ -0,0 +1,94 @@
+#ifndef SHOE_HPP
+#define SHOE_HPP
+
+#include "card.h"
+#include "rng.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Casino shoe of 1 to MAX_DECKS French decks, shuffled all at once and dealt
+// in order until the cut card comes out. Keeps the Hi-Lo running count of
+// the cards dealt, and the true count (running count per deck left).
+// Shoe i of a table is always shuffled from random stream (seed, table, i).
+// A round that runs out of cards goes on from its discards, shuffled from
+// the same stream DISCARD_BLOCK blocks further on.
+class Shoe{
+
+    public:
+        static const int MAX_DECKS = 8;
+        static const int DECK_CARDS = 52;
+        static const int MAX_CARDS = MAX_DECKS*DECK_CARDS;
+        static const int RESERVE = 15;      // Cards always left behind the cut card
+        static const uint64_t DISCARD_BLOCK = 1<<20;    // Far past the shoe's own shuffle
+
+    private:
+        Card cards[MAX_CARDS];      // Shuffled shoe, dealt from the front
+        int decks;
+        int size;                   // decks*DECK_CARDS
+        int next;                   // Next card to deal
+        int cut;                    // Position of the cut card
+        int roundStart;             // First card of the round, the ones before are discards
+        int running;                // Hi-Lo running count
+        Rng rng;
+
+        void reshuffleDiscards();
+
+    public:
+        Shoe(int d, double penetration);
+        void seed(uint64_t s, uint64_t table);
+        void shuffle(uint64_t index);
+        void load(const Card shuffled[], uint64_t index);
+        static void fill(Card out[], int decks, Rng &rng);
+        void startRound(){ roundStart = next; }
+        // Deals the next card. A round running past the last card goes on
+        // from its reshuffled discards, which only a cut card inside RESERVE allows.
+        Card deal(){
+            if(next>=size){
+                reshuffleDiscards();
+            }
+            Card c = cards[next++];
+            running += c.getHiLo();
+            return c;
+        }
+        bool needsShuffle() const { return next>=cut; }
+        int getDecks() const { return decks; }
+        int getCards() const { return size; }
+        int getSize() const { return size-next; }
+        int getRunningCount() const { return running; }
+        double getTrueCount() const { return running*(double)DECK_CARDS/(size-next>0 ? size-next : 1); }
+};
+
+// Pre-shuffled shoes for one consumer. A background thread shuffles shoes
+// [first, first+count) of a table into a ring of SLOTS shoes ahead of the
+// consumer, so the consumer only waits when it outruns the shuffler.
+class ShoeBuffer{
+
+    public:
+        static const int SLOTS = 8;
+
+    private:
+        int decks;
+        int size;                           // Cards per shoe
+        std::vector<Card> ring;             // SLOTS shoes
+        uint64_t seed, table, first, count;
+        std::atomic<uint64_t> produced;     // Shoes written to the ring
+        std::atomic<uint64_t> consumed;     // Shoes released by the consumer
+        std::atomic<bool> stopping;
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::thread producer;
+
+        void produce();
+
+    public:
+        ShoeBuffer(int d, uint64_t s, uint64_t t, uint64_t f, uint64_t n);
+        ~ShoeBuffer();
+        const Card* acquire();
+        void release();
+};
+
+#endif
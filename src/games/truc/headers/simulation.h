@@ -0,0 +1,96 @@
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include "deck.h"
+#include "gamerules.h"
+#include "hand.h"
+#include "sequential.h"
+#include "shoe.h"
+#include <cstdint>
+#include <functional>
+
+struct SimulationResult{
+
+    long long hands;                // Hands played
+    long long wins, loses, pushes;  // Outcomes from the player's side
+
+    SimulationResult();
+    void add(char result);
+    void merge(const SimulationResult &r);
+    double getEV() const;
+    double getStdError() const;
+    Welford getUnits() const;
+
+};
+
+// Results of whole shoes, also split by the true count before each hand
+struct ShoeResult{
+
+    static const int MAX_TRUE_COUNT = 6;    // Buckets -6 (or less) to +6 (or more)
+
+    long long shoes;
+    SimulationResult total;
+    SimulationResult byCount[2*MAX_TRUE_COUNT+1];
+
+    ShoeResult();
+    void merge(const ShoeResult &r);
+    static int bucket(double trueCount);
+
+};
+
+// Two strategies played on the same shuffles (common random numbers). A
+// sample is one shuffle, or an antithetic pair of shuffles, played by both;
+// its outcome is the sum of the hands' results in units (+1, 0, -1).
+struct PairedResult{
+
+    enum Series{ A, B, DIFF };
+
+    long long samples;
+    int handsPerSample;
+    SimulationResult hands[2];      // Outcome counts of A and B
+    long long sum[3], sumSq[3];     // Sample outcomes of A, B and A-B
+
+    PairedResult();
+    void add(int a, int b);
+    void merge(const PairedResult &r);
+    double getMean(Series s) const;
+    double getStdError(Series s) const;
+    double getGain() const;
+    Welford getUnits(Series s) const;
+
+};
+
+// Headless Monte Carlo runner: plays independent blackjack hands with the
+// same rules as Game, split across worker threads. With a stopping rule,
+// run(), runShoes() and compare() play chunks of hands (of shoes for
+// runShoes()) and stop at the first chunk where the rule is met, the count
+// asked for becoming the most they play.
+class Simulation{
+
+    private:
+        long long hands;    // Total number of hands to play
+        int threads;        // Worker threads
+        uint64_t seed;      // Seed shared by every hand
+        int standOn;        // Player stands at this sum or above
+        int decks;          // Decks per shoe for runShoes()
+        double penetration; // Share of the shoe dealt before the cut card
+        const StoppingRule *stopping;                   // NULL to play every hand
+        std::function<void(const Welford &w)> progress; // Called after every chunk
+        StoppingRule::Verdict verdict;                  // Why the last run stopped
+
+        void runWorker(long long first, long long count, SimulationResult *out);
+        void runShoeWorker(long long first, long long count, ShoeResult *out);
+        void runPairedWorker(long long first, long long count, const ChartOrHitBelow *players, bool antithetic, PairedResult *out);
+
+    public:
+        Simulation(long long n, int t, uint64_t s);
+        void setStandOn(int s);
+        void setShoe(int d, double p);
+        void setStopping(const StoppingRule *rule, const std::function<void(const Welford &w)> &report);
+        StoppingRule::Verdict getVerdict() const;
+        SimulationResult run();
+        ShoeResult runShoes(long long shoes);
+        PairedResult compare(const ChartOrHitBelow &a, const ChartOrHitBelow &b, bool antithetic);
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include "dealerodds.h"
+#include <cstdint>
+#include <unordered_map>
+
+// Exact expected value of hitting and standing for every player hand against
+// every dealer up-card, for the rules in Rules: any 21 ends the round (the
+// dealer wins ties at 21), and after the player stands the dealer only draws
+// (to 17) when behind. The player's hand is described by its hard sum and
+// whether it holds an ace; its cards, starting with the two dealt, are
+// removed from the shoe. The dealer's hole card is dealt before the player
+// draws and a dealer 21 ends the round at once, so every value is given
+// that the hole card doesn't make 21: the recursion carries EV times the
+// chance of that, for the cards out so far, and a cell divides by the
+// total chance once.
+// Each up-card is solved on its own thread with its own DealerOdds cache.
+// Built without a composition, the shoe is infinite: every draw is 1/13 per
+// number (4/13 for tens) and the dealer's odds come from
+// DealerOdds::getInfinite().
+class Solver{
+
+    public:
+        static const int MAX_HARD = 21;
+
+    private:
+        Composition shoe;                   // Cards left, up-card included
+        bool infinite;                      // Fixed draw odds, `shoe` unused
+        double stand[11][MAX_HARD+1][2];    // [up][hard][ace]
+        double hit[11][MAX_HARD+1][2];      // [up][hard][ace]
+
+        struct Worker{
+            int up;
+            bool infinite;
+            Composition afterUp;
+            DealerOdds odds;
+            // Memoised values by composition key: the shoe minus the cards
+            // out (the up-card and every player card) gives the player's
+            // hand, so the key alone is the state. An infinite shoe never
+            // changes, so there the key is the player's total or hand.
+            std::unordered_map<uint64_t, double> standMemo;
+            std::unordered_map<uint64_t, double> bestMemo;
+        };
+        static double weight(const Worker &w, const Composition &c, int v);
+        static double noBlackjack(const Worker &w, const Composition &c);
+        static double standEV(Worker &w, int total, const Composition &c);
+        static double hitEV(Worker &w, int hard, bool ace, Composition &c);
+        static double bestEV(Worker &w, int hard, bool ace, Composition &c);
+        void solveUp(int up);
+
+    public:
+        Solver();
+        Solver(const Composition &c);
+        void solve(int threads);
+        double getStand(int hard, bool ace, int up) const;
+        double getHit(int hard, bool ace, int up) const;
+        char getAction(int hard, bool ace, int up) const;
+        static int getTotal(int hard, bool ace);
+};
+
+#endif
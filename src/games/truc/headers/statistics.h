@@ -30,7 +30,7 @@ class Statistics{
     public:
         Statistics();
         bool check(Player pl);
-        void print();
+        void print(std::ostream &out);
         void saveStats();
         void loadStats();
 
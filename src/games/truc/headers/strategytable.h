@@ -0,0 +1,66 @@
+#ifndef STRATEGYTABLE_HPP
+#define STRATEGYTABLE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compiled bot strategy: a fixed set of decision keys mapped to actions
+// through a minimal perfect hash (hash and displace, Belazzougui et al.
+// 2009). A key picks a bucket, the bucket's displacement picks the slot, so
+// decide() is two loads and a key compare, with no probing or search.
+/*
+ * Descriptions are text, one rule per line ('#' starts a comment). Numbers
+ * can be ranges like 12-16:
+ *     play hard|soft TOTAL UP H|S     Hit or stand, UP is 1 (ace) to 10
+ *     bet CARDS_LEFT UNITS            Bet in $5 units for the cards left
+ */
+class StrategyTable{
+
+    public:
+        enum Kind{
+            PLAY = 1,
+            BET = 2
+        };
+        struct Entry{
+            uint32_t key;
+            uint8_t action;     // 'H'/'S' for PLAY, units for BET
+        };
+
+    private:
+        struct Slot{
+            uint32_t key;
+            uint32_t action;
+        };
+        std::vector<uint32_t> displacement;     // Per bucket
+        std::vector<Slot> slots;                // One per key
+
+        static uint32_t hash(uint32_t key, uint32_t seed){
+            uint64_t h = (key^((uint64_t)seed<<32))*0x9E3779B97F4A7C15ULL;
+            h ^= h>>29;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h>>32;
+            return (uint32_t)h;
+        }
+        static uint32_t reduce(uint32_t h, size_t n){ return ((uint64_t)h*n)>>32; }
+
+    public:
+        static uint32_t playKey(int total, bool soft, int up){ return PLAY<<24 | total<<16 | soft<<8 | up; }
+        static uint32_t betKey(int cardsLeft){ return BET<<24 | cardsLeft<<16; }
+        static bool parse(const std::string &line, std::vector<Entry> &out);
+        bool compile(const std::vector<Entry> &entries);
+        bool save(const std::string &path) const;
+        bool load(const std::string &path);
+        int getSize() const { return slots.size(); }
+        int getBuckets() const { return displacement.size(); }
+        // Action for key, -1 if the strategy doesn't cover it
+        int decide(uint32_t key) const{
+            if(slots.empty()){
+                return -1;
+            }
+            const Slot &s = slots[reduce(hash(key, displacement[reduce(hash(key, 0), displacement.size())]), slots.size())];
+            return s.key==key ? (int)s.action : -1;
+        }
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef TABLE_HPP
+#define TABLE_HPP
+
+#include "deck.h"
+#include "gamerules.h"
+#include "hand.h"
+#include "scheduler.h"
+#include "task.h"
+#include <cstdint>
+#include <string>
+
+class Seat;
+
+// Blackjack table driven one action at a time instead of by a blocking
+// loop: deal(), hit() and stand() take the engine's steps of a round
+// (Blackjack in gamerules.h), so a server can keep thousands of them in memory and advance each
+// when its player's message arrives. Same rules, money and deck streams as
+// Game: bets go up and down in steps of 5, the deck is reshuffled below 36
+// cards and round i is dealt from stream (seed, id, i).
+// play() runs the whole game as a coroutine that awaits each of the seat's
+// actions, so one thread can keep any number of tables in progress.
+class Table{
+
+    public:
+        typedef ClassicBlackjack Variant;   // Rule policies of the table
+
+        enum Phase{
+            BETTING,    // Raise or lower the bet, then deal
+            PLAYING,    // Hit or stand
+            OVER,       // Round finished, result is set
+            BANKRUPT    // No cash left to bet
+        };
+        enum Action{
+            RAISE, LOWER, DEAL, HIT, STAND, NEXT, LEAVE,
+            NONE        // Ignored (unknown key)
+        };
+        static const int STEP = 5;          // Bet change per raise or lower
+
+    private:
+        Deck deck;
+        Variant::State hands;
+        std::string name;
+        int cash, bet;
+        int wins, loses;
+        uint64_t round;     // Rounds started, selects the deck's random stream
+        Phase phase;
+        char result;        // 'p', 'd' or 'n' once OVER, else 'f'
+
+        void finish(char r);
+        Task<int> decide(Seat &seat, Scheduler &s, int idleMs, Action fallback);
+        Task<bool> placeBet(Seat &seat, Scheduler &s, int idleMs);
+        Task<bool> playHand(Seat &seat, Scheduler &s, int idleMs);
+
+    public:
+        Table(uint64_t seed, uint64_t id);
+        void setName(const std::string &nm){ name = nm; }
+        bool raise();
+        bool lower();
+        bool deal();
+        bool hit();
+        bool stand();
+        bool next();
+        Task<void> play(Seat &seat, Scheduler &s, int idleMs);
+
+        const std::string& getName() const { return name; }
+        Phase getPhase() const { return phase; }
+        char getResult() const { return result; }
+        int getCash() const { return cash; }
+        int getBet() const { return bet; }
+        int getWins() const { return wins; }
+        int getLoses() const { return loses; }
+        uint64_t getRound() const { return round; }
+        int getCardsLeft() const { return deck.getSize(); }
+        const Hand& getPlayer() const { return hands.player; }
+        const Hand& getDealer() const { return hands.dealer; }
+};
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+// Lazy coroutine returning T. Awaiting a task starts it and resumes the
+// awaiting coroutine when it finishes, by symmetric transfer so nested
+// tasks don't grow the stack. A task that nobody awaits is started by
+// Scheduler::start(). The Task object owns the coroutine frame: destroying
+// it destroys the frame, wherever the coroutine is suspended.
+template<class T = void>
+class Task;
+
+namespace TaskDetail{
+
+    // Resumes the awaiting coroutine, or returns to the scheduler
+    struct FinalAwaiter{
+        bool await_ready() noexcept { return false; }
+        template<class P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            std::coroutine_handle<> next = h.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+
+    struct PromiseBase{
+        std::coroutine_handle<> continuation;
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception(){ std::terminate(); }
+    };
+
+    template<class T>
+    struct Promise: PromiseBase{
+        T value;
+        Task<T> get_return_object();
+        void return_value(T v){ value = std::move(v); }
+        T result(){ return std::move(value); }
+    };
+
+    template<>
+    struct Promise<void>: PromiseBase{
+        Task<void> get_return_object();
+        void return_void(){}
+        void result(){}
+    };
+
+}
+
+template<class T>
+class Task{
+
+    public:
+        typedef TaskDetail::Promise<T> promise_type;
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+    public:
+        Task(): handle(nullptr) {}
+        explicit Task(std::coroutine_handle<promise_type> h): handle(h) {}
+        Task(Task &&o) noexcept: handle(std::exchange(o.handle, nullptr)) {}
+        Task(const Task&) = delete;
+        Task& operator=(Task &&o) noexcept {
+            if(this!=&o){
+                if(handle){
+                    handle.destroy();
+                }
+                handle = std::exchange(o.handle, nullptr);
+            }
+            return *this;
+        }
+        ~Task(){
+            if(handle){
+                handle.destroy();
+            }
+        }
+        bool done() const { return !handle || handle.done(); }
+        std::coroutine_handle<> getHandle() const { return handle; }
+
+        // Awaiting runs the task until it finishes
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+            handle.promise().continuation = caller;
+            return handle;
+        }
+        T await_resume(){ return handle.promise().result(); }
+};
+
+template<class T>
+inline Task<T> TaskDetail::Promise<T>::get_return_object(){
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskDetail::Promise<void>::get_return_object(){
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+#endif
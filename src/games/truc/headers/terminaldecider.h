@@ -0,0 +1,18 @@
+#ifndef TERMINALDECIDER_HPP
+#define TERMINALDECIDER_HPP
+
+#include "decider.h"
+
+// Human at the keyboard. Keys are read one at a time without echo; the game
+// draws the table and the prompts before asking.
+class TerminalDecider: public Decider{
+
+    public:
+        bool isHuman() const { return true; }
+        int chooseBet(int cash, int bet, int cardsLeft);
+        bool chooseHit(const Hand &player, Card up);
+        bool keepPlaying();
+        uint8_t chooseTrucMove(const TrucState &s);
+};
+
+#endif
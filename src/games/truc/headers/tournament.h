@@ -0,0 +1,104 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+
+#include "decider.h"
+#include "strategytable.h"
+#include "truccfr.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Strategy-vs-strategy tournament, round robin or Swiss, for Truc bots or
+// blackjack strategies. Every pairing plays the same games: Truc game g is
+// dealt from stream (seed, g/2) with the sides swapped on odd g, blackjack
+// game g is a session of `rounds` rounds that both strategies play on table
+// (seed, g) and the higher cash wins. Games are cut in batches run by a
+// WorkPool, and every finished batch is appended to the checkpoint file, so
+// an interrupted run resumes where it stopped. Ratings are Elo-scaled
+// Bradley-Terry strengths fitted to every game played.
+/*
+ * Entrants:
+ *     baseline        Truc: heuristic cards, no bids, every bid accepted
+ *     random          Truc: random legal moves
+ *     cfr:FILE        Truc: baseline cards with the bids of a TrucCfr file
+ *     mcts:MS         Truc: TrucBot thinking MS per decision (one thread)
+ *     chart:FILE      Blackjack: compiled StrategyTable
+ *     hit:N           Blackjack: hits below N, $5 bets
+ */
+class Tournament{
+
+    public:
+        enum Game{ TRUC, BLACKJACK };
+        enum Format{ ROUND_ROBIN, SWISS };
+
+        // Games of entrant a against entrant b
+        struct Result{
+            long long wins[2];      // Of a and b
+            long long draws;
+            long long margin;       // Points (Truc) or cash (blackjack) of a minus b
+        };
+
+    private:
+        enum Kind{ BASELINE, RANDOM, CFR, MCTS, CHART, HIT };
+
+        struct Entrant{
+            std::string spec;
+            Kind kind;
+            int value;                          // Think time or hit total
+            std::shared_ptr<TrucCfr> cfr;
+            std::shared_ptr<StrategyTable> chart;
+        };
+        static const int BATCH_BYTES = 3*2+2*4+4*8;     // Batch in the checkpoint file
+
+        // Games [first, first+count) of a against b in a round
+        struct Batch{
+            uint16_t round, a, b;
+            uint32_t first, count;
+            Result result;
+        };
+
+        std::vector<Entrant> entrants;
+        Game game;
+        Format format;
+        int swissRounds;
+        int games;          // Per pairing
+        int players;        // Truc seats (2 or 4)
+        int rounds;         // Blackjack rounds per game
+        int threads;
+        uint64_t seed;
+        std::string path;                   // Checkpoint file
+        std::vector<Batch> done;            // Batches played, from every run
+        std::vector<Result> pairs;          // a*n+b, for a<b
+        std::vector<double> points;         // Swiss standings
+        std::vector<std::vector<std::unique_ptr<Decider> > > seats;    // mcts players, by worker and entrant
+        std::ofstream checkpoint;
+        std::mutex writing;                 // Held to append a batch to the checkpoint
+        long long resumed;                  // Batches read back from the file
+        long long steals;
+
+        std::string describe() const;
+        void record(const Batch &b);
+        static void encode(std::string &out, const Batch &b);
+        static Batch decode(const char *p);
+        void playRound(int round, const std::vector<std::pair<int,int> > &pairings);
+        Result playBatch(int worker, const Batch &b);
+        std::unique_ptr<Decider> makeDecider(int e, uint64_t stream);
+        std::vector<std::pair<int,int> > swissPairings(int round);
+        Result& pair(int a, int b){ return pairs[a*entrants.size()+b]; }
+
+    public:
+        Tournament(Format f, int swiss, int g, int p, int r, int t, uint64_t s);
+        bool addEntrant(const std::string &spec, std::string &error);
+        bool open(const std::string &file, std::string &error);
+        void run();
+        std::vector<double> ratings() const;
+        void print(std::ostream &out) const;
+        long long getResumed() const { return resumed; }
+        long long getSteals() const { return steals; }
+};
+
+#endif
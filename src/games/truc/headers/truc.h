@@ -1 +1,80 @@
-#include "game.h"
\ No newline at end of file
+#ifndef TRUC_HPP
+#define TRUC_HPP
+
+#include "sequential.h"
+#include "strategytable.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class Decider;
+class Solver;
+
+// Modes of the truc command, one translation unit each (simulatemode.cpp,
+// solvemode.cpp ...). truc.cpp parses the options and runs one of them;
+// each returns the exit code of the program.
+
+// Progress line of a sequential run on stderr, redrawn at most 4 times a second
+class ProgressLine{
+
+    private:
+        const char *unit;
+        const StoppingRule &rule;
+        std::chrono::steady_clock::time_point last;
+        bool shown;
+
+    public:
+        ProgressLine(const char *u, const StoppingRule &r): unit(u), rule(r), shown(false) {}
+        void show(const Welford &w, bool force=false){
+            auto now = std::chrono::steady_clock::now();
+            if(!force && shown && now-last<std::chrono::milliseconds(250)){
+                return;
+            }
+            last = now;
+            shown = true;
+            std::cerr<<"\r"<<unit<<" "<<w.n<<": "<<std::fixed<<std::setprecision(4)<<w.mean<<" +/- "<<1.96*w.getStdError();
+            if(rule.isSprt()){
+                std::cerr<<", LLR "<<std::setprecision(2)<<rule.getLlr(w);
+            }
+            std::cerr<<"    "<<std::flush;
+        }
+        // Redraws the final estimate and leaves the line
+        void end(const Welford &w){
+            if(shown){
+                show(w, true);
+                std::cerr<<"\n";
+            }
+        }
+};
+
+void printVerdict(StoppingRule::Verdict v, const StoppingRule &rule, const Welford &w, const char *quantity);
+std::vector<StrategyTable::Entry> chartEntries(const Solver &solver);
+int writeStrategy(const std::vector<StrategyTable::Entry> &entries, const std::string &path);
+
+// Blackjack
+int play(uint64_t seed, long long rounds, const StrategyTable *strategy, Decider *script);
+int simulate(long long hands, int threads, uint64_t seed, const StoppingRule &rule);
+int compare(long long hands, const std::vector<std::string> &specs, bool antithetic, int threads, uint64_t seed, const StoppingRule &rule);
+int simulateShoes(long long shoes, int decks, double penetration, int threads, uint64_t seed, const StoppingRule &rule);
+int bench(long long hands, uint64_t seed);
+int solve(int decks, int threads, const std::string &path);
+int compileStrategy(const std::string &source, const std::string &path);
+int playTables(int count, long long rounds, const StrategyTable *strategy, uint64_t seed);
+
+// Truc
+int generateEquity(const std::string &path, int samples, int threads, uint64_t seed);
+int trucMatch(int games, int players, int thinkMs, int threads, uint64_t seed, const std::string &cfrPath,
+              const std::string &equityPath, Decider *opponent, const StoppingRule &rule);
+int solveDeals(const std::string &path, int threads);
+int trainCfr(const std::string &path, long long iterations, int threads, uint64_t seed);
+
+// Network and tournaments
+int serve(const std::string &address, int threads, int idleMs, uint64_t seed);
+int joinServer(const std::string &address, int clients, long long rounds);
+int tournament(const std::string &path, const std::vector<std::string> &specs, int swiss, int games, int players, long long rounds,
+               int threads, uint64_t seed);
+
+#endif
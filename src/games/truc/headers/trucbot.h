@@ -0,0 +1,60 @@
+#ifndef TRUCBOT_HPP
+#define TRUCBOT_HPP
+
+#include "equity.h"
+#include "rng.h"
+#include "truccfr.h"
+#include "trucstate.h"
+#include <cstdint>
+#include <vector>
+
+// Truc player using information-set Monte Carlo tree search (single
+// observer ISMCTS, Cowling et al. 2012). Each iteration deals the cards the
+// bot can't see at random (a determinization), walks one shared tree over
+// the moves that are legal in that deal, and finishes the hand with
+// TrucState::heuristicCard(). Search is root-parallel: every thread grows its
+// own tree and the root visit counts are summed when the deadline passes.
+// Nodes live in per-thread pools that are reused between decisions. With a
+// trained TrucCfr set, opening bids come from its strategy instead. With a
+// loaded EquityTable, truc and envit bids made while the bot still holds its
+// three cards are table lookups and the search only picks the card.
+class TrucBot{
+
+    public:
+        struct Node{
+            int32_t firstChild;     // Index in the pool, -1 if none
+            int32_t nextSibling;
+            uint32_t visits;
+            uint32_t available;     // Times the move was legal when selecting
+            float reward;           // Sum of rewards for the seat that moved
+            uint8_t move;
+            uint8_t seat;           // Seat that made `move`
+        };
+        static const int MAX_NODES = 1<<20;     // Per thread, search stops expanding beyond
+
+    private:
+        int threads;                            // Root-parallel workers
+        int deadlineMs;                         // Thinking time per decision
+        uint64_t seed;
+        uint64_t decisions;                     // Decisions made, selects the random streams
+        long long lastPlayouts;                 // Playouts in the last decision
+        const TrucCfr *bidding;                 // Bidding strategy, NULL to search bids too
+        const EquityTable *equity;              // Hand equities for bids, NULL to search them
+        std::vector<std::vector<Node> > pools;  // One node pool per worker
+
+        void search(int worker, const TrucState &root, long long deadline, uint32_t visits[TrucState::MOVES], long long *playouts);
+        static void determinize(TrucState &s, int seat, Rng &rng);
+        static uint8_t rolloutMove(const TrucState &s, Rng &rng);
+        static float reward(const TrucState &s, int seat);
+        uint8_t tableBid(const TrucState &s) const;
+
+    public:
+        TrucBot(int t, int ms, uint64_t s);
+        uint8_t decide(const TrucState &s);
+        long long getLastPlayouts() const { return lastPlayouts; }
+        void setDeadline(int ms){ deadlineMs = ms; }
+        void setBidding(const TrucCfr *cfr){ bidding = cfr; }
+        void setEquity(const EquityTable *e){ equity = e!=NULL && e->isLoaded() ? e : NULL; }
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef TRUCCFR_HPP
+#define TRUCCFR_HPP
+
+#include "rng.h"
+#include "trucstate.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CFR+ trainer for an abstraction of Truc bidding. Both teams are reduced to
+// one player: P0 is the mà's team and P1 the other one. The abstract game is
+// an envit round (envit, torne, vull/no vull) followed by a truc round
+// (truc, retruc, val quatre, vull/no vull), where "pass" means playing a card
+// instead of bidding. Hands are bucketed by their envit and truc strength
+// from TrucHands. At the end the envit goes to the best envit (the mà on
+// ties) and the truc to the double-dummy winner of the deal. Deals are
+// 1v1, so the strategy only answers for 2-player tables.
+//
+// Regrets and strategy sums live in flat arrays indexed by information set
+// (node * BUCKETS + bucket) * MAX_ACTIONS. Each iteration samples one deal
+// and walks the whole betting tree (chance-sampled CFR with regret
+// matching+ and linear averaging). Worker threads add into their own delta
+// buffers for a batch of iterations, and the deltas are merged between
+// batches, so the hot loop takes no locks.
+class TrucCfr{
+
+    public:
+        static const int ENVIT_BUCKETS = 5;
+        static const int STRENGTH_BUCKETS = 6;
+        static const int BUCKETS = ENVIT_BUCKETS*STRENGTH_BUCKETS;
+        static const int MAX_ACTIONS = 3;
+        static const uint8_t PASS = 0xFF;       // Abstract action: play a card, no bid
+        static const int KEYS = 2*10*2*4*2;     // Encoded bidding positions
+
+        struct Node{
+            int8_t player;                  // 0, 1, or -1 for a terminal node
+            uint8_t actions;
+            uint8_t action[MAX_ACTIONS];    // PASS or a TrucState move
+            int16_t child[MAX_ACTIONS];
+            // Terminal payoff description
+            int8_t envitFixedTeam;          // Team paid for a rejected envit (-1 none)
+            uint8_t envitPoints;            // Rejected or accepted envit points
+            int8_t trucFixedTeam;           // Team paid for a rejected truc (-1 showdown)
+            uint8_t trucPoints;
+        };
+
+    private:
+        std::vector<Node> nodes;
+        int16_t nodeOf[KEYS];           // Decision node of an encoded position
+        std::vector<float> regret;      // Positive regrets (CFR+)
+        std::vector<float> strategySum; // Weighted sums of the current strategies
+        long long iterations;           // Iterations trained so far
+        long long batches;              // Batches merged so far (averaging weight)
+
+        static int key(int stage, int envitLeaf, int toAct, int pending, int passes);
+        int buildEnvit(int toAct, int pending, int passes);
+        int buildTruc(int envitLeaf, const Node &envit, int toAct, int pending, int passes);
+        int addTerminal(const Node &envit, int trucFixedTeam, int trucPoints);
+        uint8_t sample(int infoset, Rng &rng) const;
+        void currentStrategy(int infoset, int actions, float sigma[MAX_ACTIONS]) const;
+        float walk(int node, const int bucket[2], int envitWinner, int trucWinner, float reach0, float reach1,
+                   float *regretDelta, float *strategyDelta) const;
+        static int envitLeafOf(const TrucState &s, int manoTeam);
+
+    public:
+        TrucCfr();
+        static int bucket(const Card cards[3]);
+        int getInfosets() const { return nodes.size()*BUCKETS; }
+        long long getIterations() const { return iterations; }
+        void train(long long count, int threads, uint64_t seed, int batch);
+        bool save(const std::string &path) const;
+        bool load(const std::string &path);
+        int infosetOf(const TrucState &s) const;
+        void getStrategy(int infoset, float out[MAX_ACTIONS]) const;
+        uint8_t decide(const TrucState &s, Rng &rng) const;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef TRUCHANDS_HPP
+#define TRUCHANDS_HPP
+
+#include "card.h"
+#include <array>
+#include <cstdint>
+
+// Precomputed row for a 3-card Truc hand
+struct TrucHandInfo{
+
+    uint8_t envit;          // Envit score (20 + two best of a suit, else best card)
+    uint8_t flor;           // 1 when the three cards share a suit
+    uint16_t signature;     // Truc ranks sorted high to low, 4 bits each
+
+    int getRank(int i) const { return (signature>>(8-4*i))&15; }
+
+};
+
+namespace TrucHandTable{
+
+    // Deck index (0..39) of a Spanish card, from its code: suit*10 + position
+    constexpr std::array<int8_t, CardTable::CODES> makeDeckIndex(){
+        std::array<int8_t, CardTable::CODES> t{};
+        constexpr int8_t byNumber[16] = {-1, 0, 1, 2, 3, 4, 5, 6, -1, -1, 7, 8, 9, -1, -1, -1};
+        for(int c=0;c<CardTable::CODES;c++){
+            t[c] = byNumber[c&15]<0 ? -1 : (c>>4)*10+byNumber[c&15];
+        }
+        return t;
+    }
+
+    constexpr std::array<int8_t, CardTable::CODES> DECK_INDEX = makeDeckIndex();
+    constexpr int NUMBERS[10] = {1, 2, 3, 4, 5, 6, 7, 10, 11, 12};
+
+}
+
+// Every 3-card hand of the 40-card deck (C(40,3) = 9880) has a row in a table
+// generated at compile time. A hand's row is found by its combinatorial
+// (colex) index: with deck indices a<b<c, index = C(a,1)+C(b,2)+C(c,3), so
+// envit and strength lookups are a few adds and one load, in any card order.
+struct TrucHands{
+
+    static const int CARDS = 40;
+    static const int HANDS = 9880;
+
+    static const std::array<TrucHandInfo, HANDS> table;
+
+    static constexpr int choose2(int n){ return n*(n-1)/2; }
+    static constexpr int choose3(int n){ return n*(n-1)*(n-2)/6; }
+
+    // Colex index of three distinct deck indices, in any order
+    static constexpr int indexOf(int a, int b, int c){
+        int t = 0;
+        if(a>b){ t = a; a = b; b = t; }
+        if(b>c){ t = b; b = c; c = t; }
+        if(a>b){ t = a; a = b; b = t; }
+        return a+choose2(b)+choose3(c);
+    }
+    static int index(const Card cards[3]){
+        return indexOf(TrucHandTable::DECK_INDEX[cards[0].getCode()], TrucHandTable::DECK_INDEX[cards[1].getCode()],
+                       TrucHandTable::DECK_INDEX[cards[2].getCode()]);
+    }
+    static const TrucHandInfo& get(const Card cards[3]){
+        return table[index(cards)];
+    }
+    static constexpr Card cardAt(int deckIndex){
+        return Card(TrucHandTable::NUMBERS[deckIndex%10], CardTable::SUITS[deckIndex/10]);
+    }
+    static void handAt(int idx, Card out[3]);
+
+};
+
+#endif
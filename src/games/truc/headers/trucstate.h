@@ -0,0 +1,111 @@
+#ifndef TRUCSTATE_HPP
+#define TRUCSTATE_HPP
+
+#include "card.h"
+#include "deck.h"
+#include <cstdint>
+#include <type_traits>
+
+// Whole state of a Truc game (2 players, or 4 in two partnerships) as a
+// small trivially-copyable struct, so search and simulation can copy it
+// freely. Seats play in order 0, 1, 2, 3 and team = seat % 2.
+/*
+ * Hand: 3 bazas with the 40-card deck, a team wins with 2 bazas. A parda
+ * (tie) in the first baza is settled by the next one, a parda later on goes
+ * to the winner of the first baza, and three pardas go to the mà's team.
+ * The seat that played the winning card leads the next baza (after a parda
+ * the same seat leads again).
+ *
+ * Truc: 1 point, truc 2, retruc 3, val quatre 4, joc fora wins the game.
+ * Only the team that didn't make the last raise can raise again. Rejecting
+ * gives the raising team the previous value.
+ *
+ * Envit: only during the first baza, before the caller has played. Envit 2,
+ * torne 4, falta (what the leading team lacks to win). Rejecting gives the
+ * previous value (1 for a plain envit). Accepted envits are settled at the
+ * end of the hand: highest envit wins, ties go to the seat nearest the mà.
+ * Nothing can be called while another bid waits for an answer.
+ */
+struct TrucState{
+
+    enum Move : uint8_t{
+        PLAY_FIRST = 0,     // Play card 0, 1 or 2 of the hand
+        PLAY_SECOND,
+        PLAY_THIRD,
+        TRUC,               // Call or raise the truc
+        ENVIT,              // Call envit, or raise it to torne
+        FALTA,              // Call or raise to falta envit
+        ACCEPT,             // Vull
+        REJECT,             // No vull
+        MOVES
+    };
+    enum Phase : uint8_t{
+        PLAY,               // `turn` must play a card (or call)
+        RESPOND,            // `turn` must answer a pending bid
+        HAND_OVER,
+        GAME_OVER
+    };
+    static const int MAX_PLAYERS = 4;
+    static const int HAND_CARDS = 3;
+    static const int JOC_FORA = 4;      // Highest truc level
+    static const int FALTA_ENVIT = 3;   // Highest envit level
+    static const int8_t PARDA = 2;      // Baza result when tied
+
+    Card hands[MAX_PLAYERS][HAND_CARDS];    // Cards dealt to each seat
+    Card table[MAX_PLAYERS];                // Cards played in this baza
+    uint16_t played;                        // Bit seat*3+i when hands[seat][i] was played
+    uint8_t players;                        // 2 or 4
+    uint8_t phase;
+    uint8_t mano;                           // Seat leading the first baza
+    uint8_t turn;                           // Seat to move
+    uint8_t leader;                         // Seat that led this baza
+    uint8_t baza;                           // Current baza (0 to 2)
+    uint8_t inBaza;                         // Cards played in this baza
+    int8_t bazaWinner[HAND_CARDS];          // Team, PARDA, or -1 when not played
+    uint8_t trucLevel;                      // Accepted truc level (0 to JOC_FORA)
+    int8_t trucOwner;                       // Team that made the last truc raise (-1 none)
+    uint8_t envitLevel;                     // Accepted envit level (0 to FALTA_ENVIT)
+    int8_t envitOwner;                      // Team that made the last envit raise (-1 none)
+    uint8_t envitClosed;                    // Envit can't be called any more
+    uint8_t pending;                        // TRUC or ENVIT bid waiting for an answer (0 none)
+    uint8_t pendingLevel;                   // Level of the pending bid
+    uint8_t resumeTurn;                     // Seat that continues once the bid is answered
+    int8_t handWinner;                      // Team that won the hand (-1 while playing)
+    uint8_t handPoints[2];                  // Points earned by each team this hand
+    uint8_t rejectedEnvit[2];               // Points for a rejected envit this hand
+    uint8_t score[2];                       // Game score
+    uint8_t target;                         // Points to win the game
+
+    void newGame(int numPlayers, int goal);
+    void dealHand(Deck &deck, int manoSeat);
+    void startHand(int manoSeat);
+    int legalMoves(uint8_t out[MOVES]) const;
+    bool isLegal(uint8_t m) const;
+    void apply(uint8_t m);
+    int heuristicCard() const;
+
+    int getTeam(int seat) const { return seat&1; }
+    bool hasPlayed(int seat, int i) const { return (played>>(seat*HAND_CARDS+i))&1; }
+    bool isHandOver() const { return phase>=HAND_OVER; }
+    bool isGameOver() const { return phase==GAME_OVER; }
+    int getGameWinner() const;
+    int getEnvitWinner() const;
+    int getFalta() const;
+    static int envitOf(const Card cards[HAND_CARDS]);
+    static int trucValue(int level);
+    static int envitValue(int level);
+    static const char* moveName(uint8_t m);
+
+    private:
+        void playCard(int i);
+        void endBaza();
+        int decideHand() const;
+        void finishHand(int team);
+        void answer(uint8_t m);
+        bool canCallEnvit() const;
+};
+
+static_assert(std::is_trivially_copyable<TrucState>::value, "TrucState is copied as raw bytes");
+static_assert(sizeof(TrucState)<=64, "TrucState should fit in a cache line");
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef WORKPOOL_HPP
+#define WORKPOOL_HPP
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Thread pool with work stealing for jobs of uneven length. Jobs 0..n-1 are
+// dealt round robin to one deque per worker; a worker takes its own from the
+// back and, once it runs dry, steals from the front of the others. Each
+// deque has its own lock, which is only contended by a steal.
+class WorkPool{
+
+    private:
+        struct Queue{
+            std::mutex mutex;
+            std::deque<int> jobs;
+        };
+
+        int threads;
+        std::vector<Queue> queues;
+        std::atomic<long long> steals;
+
+        bool take(int worker, int &job);
+
+    public:
+        WorkPool(int t);
+        void run(const std::vector<int> &jobs, const std::function<void(int worker, int job)> &work);
+        long long getSteals() const { return steals.load(); }
+};
+
+#endif
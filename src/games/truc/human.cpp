@@ -1,62 +1,32 @@
 #include "headers/human.h"
-#include <iostream>
+#include <vector>
 
-// Default Constructor
-Human::Human(){
-    sum = 0;
-}
-
-// Getter Function for sum to check end of game
-int Human::getSum(){
-    switchAce();
-    return sum;
-}
-
-// Switches Ace between 1 and 11
-void Human::switchAce(){
-    if(sum>21){
-        for(int i=0;i<hand.size();i++){
-                if(hand[i].getNumber()==1 && !(hand[i].getBlock())){
-                    hand[i].setBlock(true);
-                    sum-=10;
-                    return;
-                }
+// Text rows of every card code, rendered once on the first call
+const std::string& Human::cardRow(Card c, int row){
+    static const std::vector<std::string> rows = [](){
+        std::vector<std::string> r(CardTable::CODES*CARD_ROWS);
+        for(int code=0;code<CardTable::CODES;code++){
+            Card k = Card::fromCode(code);
+            std::string *card = &r[code*CARD_ROWS];
+            card[0] = ".------.";
+            card[1] = std::string("|")+k.getPrintNumber()+".--. |";
+            card[2] = k.getPrintL1();
+            card[3] = k.getPrintL2();
+            card[4] = std::string("| '--'")+k.getPrintNumber()+"|";
+            card[5] = "`------'";
         }
-    }
-}
-
-// Adds card to Human's hand
-void Human::addCard(Card c){
-    hand.push_back(c);
-    if(c.getNumber()>10){
-        c.setNumber(10);
-    }
-    else if (c.getNumber()==1){
-        c.setNumber(11);
-    }
-    sum+= c.getNumber();
-}
-
-// Clears Human's hand
-void Human::clearCards(){
-    hand.clear();
-    sum = 0;
+        return r;
+    }();
+    return rows[c.getCode()*CARD_ROWS+row];
 }
 
 // Prints Human's cards
-void Human::printCards(){
-    std::cout<<"\n";
-    for(int i=0;i<6;i++){
-        for(int j=0;j<hand.size();j++){
-            switch(i){
-                case 0: std::cout<<".------."; break;
-                case 1: std::cout<<"|"<<hand[j].getPrintNumber()<<".--. |"; break;
-                case 2: hand[j].printCardL1(); break;
-                case 3: hand[j].printCardL2(); break;
-                case 4: std::cout<<"| '--'"<<hand[j].getPrintNumber()<<"|"; break;
-                case 5: std::cout<<"`------'";
-            }
+void Human::printCards(std::ostream &out){
+    out<<"\n";
+    for(int i=0;i<CARD_ROWS;i++){
+        for(int j=0;j<count && j<MAX_CARDS;j++){
+            out<<cardRow(cards[j], i);
         }
-        std::cout<<"\n";
+        out<<"\n";
     }
-}
\ No newline at end of file
+}
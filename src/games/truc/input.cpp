@@ -0,0 +1,258 @@
+#include "headers/input.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef _WIN32
+#include <conio.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <csignal>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+static struct termios original;        // Terminal settings before the session
+static struct termios rawMode;         // Raw settings of the session
+static volatile sig_atomic_t saved = 0;
+
+// Puts the terminal back and lets the signal do what it would have done
+static void onSignal(int sig){
+    if(sig==SIGCONT){
+        if(saved){
+            tcsetattr(0, TCSANOW, &rawMode);
+        }
+        return;
+    }
+    Input::restore();
+    signal(sig, SIG_DFL);
+    raise(sig);
+    if(sig==SIGTSTP){
+        // Resumed: handle the next stop too
+        signal(SIGTSTP, onSignal);
+    }
+}
+#endif
+
+//////////////* Session *////
+
+Input::Input(){
+    next = 0;
+    nextTimer = 0;
+    started = false;
+    closed = false;
+}
+
+Input& Input::session(){
+    static Input input;
+    if(!input.started){
+        input.enter();
+    }
+    return input;
+}
+
+// Raw mode for the whole session: keys arrive one by one, without echo
+void Input::enter(){
+    started = true;
+#ifndef _WIN32
+    if(!isatty(0) || tcgetattr(0, &original)<0){
+        return;
+    }
+    rawMode = original;
+    rawMode.c_lflag &= ~(ICANON | ECHO);
+    rawMode.c_cc[VMIN] = 1;
+    rawMode.c_cc[VTIME] = 0;
+    if(tcsetattr(0, TCSANOW, &rawMode)<0){
+        return;
+    }
+    saved = 1;
+    atexit(restore);
+    const int signals[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT, SIGTSTP, SIGCONT};
+    for(int sig: signals){
+        signal(sig, onSignal);
+    }
+#endif
+}
+
+// Safe to call from a signal handler
+void Input::restore(){
+#ifndef _WIN32
+    if(saved){
+        tcsetattr(0, TCSANOW, &original);
+    }
+#endif
+}
+
+int64_t Input::now(){
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//////////////* Reading *////
+
+// Waits up to timeoutMs (-1 = forever) for keys and queues all that are ready
+bool Input::fill(int timeoutMs){
+    if(next==keys.size()){
+        keys.clear();
+        next = 0;
+    }
+#ifdef _WIN32
+    if(closed){
+        Sleep(timeoutMs);
+        return false;
+    }
+    int64_t end = now()+timeoutMs;
+    while(!_kbhit()){
+        if(timeoutMs>=0 && now()>=end){
+            return false;
+        }
+        Sleep(1);
+    }
+    while(_kbhit()){
+        keys.push_back((char)_getch());
+    }
+    return true;
+#else
+    if(closed){
+        // Nothing more to read, only timers to wait for
+        ::poll(NULL, 0, timeoutMs);
+        return false;
+    }
+    struct pollfd p = {0, POLLIN, 0};
+    if(::poll(&p, 1, timeoutMs)<=0){
+        return false;
+    }
+    char buf[256];
+    ssize_t n = read(0, buf, sizeof(buf));
+    if(n<=0){
+        closed = n==0 || !(p.revents & POLLIN);
+        return false;
+    }
+    keys.append(buf, n);
+    return true;
+#endif
+}
+
+// Next key or expired timer, whichever comes first; false after timeoutMs
+bool Input::wait(Event &e, int timeoutMs){
+    int64_t end = timeoutMs<0 ? -1 : now()+timeoutMs;
+    while(true){
+        if(next<keys.size()){
+            e.type = KEY;
+            e.key = (unsigned char)keys[next++];
+            return true;
+        }
+        int64_t t = now();
+        int first = -1;
+        for(size_t i=0;i<timers.size();i++){
+            if(first<0 || timers[i].deadline<timers[first].deadline){
+                first = i;
+            }
+        }
+        if(first>=0 && timers[first].deadline<=t){
+            e.type = TIMER;
+            e.timer = timers[first].id;
+            timers.erase(timers.begin()+first);
+            return true;
+        }
+        if(end>=0 && t>=end){
+            e.type = NONE;
+            return false;
+        }
+        int64_t until = end;
+        if(first>=0 && (until<0 || timers[first].deadline<until)){
+            until = timers[first].deadline;
+        }
+        if(closed && until<0){
+            e.type = NONE;
+            return false;
+        }
+        fill(until<0 ? -1 : (int)(until-t));
+    }
+}
+
+// Blocks for one key; timers stay pending for the next wait(). The session
+// ends when the input does.
+int Input::key(){
+    while(next==keys.size()){
+        if(closed){
+            exit(0);
+        }
+        fill(-1);
+    }
+    return (unsigned char)keys[next++];
+}
+
+// Writes the echo of a key straight to the terminal, after what cout holds
+static void echo(const char *s, size_t n){
+    std::cout.flush();
+#ifdef _WIN32
+    std::cout.write(s, n);
+    std::cout.flush();
+#else
+    size_t done = 0;
+    while(done<n){
+        ssize_t w = write(STDOUT_FILENO, s+done, n-done);
+        if(w<=0){
+            break;
+        }
+        done += w;
+    }
+#endif
+}
+
+// Echoed word ended by Enter, for names and menu answers
+std::string Input::word(){
+    std::string line;
+    std::cout.flush();
+    while(true){
+        int c = key();
+        if(c=='\n' || c=='\r'){
+            size_t b = line.find_first_not_of(' ');
+            if(b!=std::string::npos){
+                echo("\n", 1);
+                return line.substr(b, line.find(' ', b)-b);
+            }
+        }
+        else if(c==127 || c=='\b'){
+            if(!line.empty()){
+                line.pop_back();
+                echo("\b \b", 3);
+            }
+        }
+        else if(c>=' '){
+            line.push_back((char)c);
+            char ch = c;
+            echo(&ch, 1);
+        }
+    }
+}
+
+// Echoed key, skipping blanks, for single-choice prompts
+char Input::answer(){
+    int c;
+    do{
+        c = key();
+    } while(c<=' ');
+    char echoed[2] = {(char)c, '\n'};
+    echo(echoed, 2);
+    return echoed[0];
+}
+
+//////////////* Timers *////
+
+// Fires once, ms from now, as a TIMER event carrying the returned id
+int Input::addTimer(int ms){
+    Timer t = {nextTimer++, now()+ms};
+    timers.push_back(t);
+    return t.id;
+}
+
+void Input::cancelTimer(int id){
+    for(size_t i=0;i<timers.size();i++){
+        if(timers[i].id==id){
+            timers.erase(timers.begin()+i);
+            return;
+        }
+    }
+}
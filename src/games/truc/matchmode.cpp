@@ -0,0 +1,75 @@
+#include "headers/truc.h"
+#include "headers/botdecider.h"
+#include "headers/equity.h"
+#include "headers/trucbot.h"
+#include "headers/truccfr.h"
+#include "headers/trucstate.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Plays Truc games with the MCTS bot on team 0 against `opponent` on team 1.
+// The bot takes its opening bids from the strategy in `cfrPath` and its
+// other bids from the table in `equityPath` when they are not empty. With
+// an active `rule` the match ends once the bot's win rate meets it.
+int trucMatch(int games, int players, int thinkMs, int threads, uint64_t seed, const std::string &cfrPath,
+              const std::string &equityPath, Decider *opponent, const StoppingRule &rule){
+    TrucCfr cfr;
+    if(!cfrPath.empty() && !cfr.load(cfrPath)){
+        std::cerr<<"Could not load "<<cfrPath<<"\n";
+        return 1;
+    }
+    EquityTable equity;
+    if(!equityPath.empty() && !equity.load(equityPath)){
+        std::cerr<<"Could not load "<<equityPath<<"\n";
+        return 1;
+    }
+    TrucBot bot(threads, thinkMs, seed);
+    bot.setBidding(cfrPath.empty() ? NULL : &cfr);
+    bot.setEquity(equityPath.empty() ? NULL : &equity);
+    BotDecider self(NULL, &bot, 0);
+    Decider *teams[2] = {&self, opponent};
+    Deck deck(Deck::SPANISH);
+    deck.seed(seed, 1);
+    int wins = 0, played = 0;
+    long long playouts = 0, decisions = 0, hands = 0;
+    Welford won;
+    ProgressLine line("Games", rule);
+    StoppingRule::Verdict verdict = StoppingRule::CONTINUE;
+    auto start = std::chrono::steady_clock::now();
+    for(int g=0;g<games && verdict==StoppingRule::CONTINUE;g++){
+        TrucState s;
+        s.newGame(players, 24);
+        int mano = g%players;
+        while(!s.isGameOver()){
+            deck.setHand(hands++);
+            s.dealHand(deck, mano);
+            while(!s.isHandOver()){
+                int team = s.getTeam(s.turn);
+                s.apply(teams[team]->chooseTrucMove(s));
+                if(team==0){
+                    playouts += bot.getLastPlayouts();
+                    decisions++;
+                }
+            }
+            mano = (mano+1)%players;
+        }
+        wins += s.getGameWinner()==0;
+        played++;
+        if(rule.isActive()){
+            won.add(s.getGameWinner()==0 ? 1.0 : 0.0);
+            line.show(won);
+            verdict = rule.check(won);
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    line.end(won);
+    std::cout<<std::fixed<<std::setprecision(1);
+    std::cout<<"Bot won "<<wins<<" of "<<played<<" games ("<<100.0*wins/(played>0 ? played : 1)<<" %)\n";
+    std::cout<<"Playouts: "<<(decisions>0 ? playouts/decisions : 0)<<" per decision, "
+             <<(secs>0 ? playouts/secs/1000 : 0.0)<<" k/s over "<<threads<<" threads\n";
+    if(rule.isActive()){
+        printVerdict(verdict, rule, won, "Win rate");
+    }
+    return 0;
+}
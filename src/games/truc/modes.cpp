@@ -0,0 +1,23 @@
+#include "headers/truc.h"
+#include <iomanip>
+#include <iostream>
+
+// Helpers shared by the modes declared in truc.h
+
+// Why a sequential run stopped
+void printVerdict(StoppingRule::Verdict v, const StoppingRule &rule, const Welford &w, const char *quantity){
+    std::cout<<std::fixed<<std::setprecision(4);
+    switch(v){
+        case StoppingRule::PRECISE:
+            std::cout<<"Stopped: interval reached +/- "<<1.96*w.getStdError()<<" after "<<w.n<<" samples\n";
+            break;
+        case StoppingRule::ACCEPT_M0:
+        case StoppingRule::ACCEPT_M1:
+            std::cout<<"SPRT:    "<<quantity<<" = "<<(v==StoppingRule::ACCEPT_M1 ? rule.getM1() : rule.getM0())<<" accepted over "
+                     <<(v==StoppingRule::ACCEPT_M1 ? rule.getM0() : rule.getM1())<<" after "<<w.n<<" samples (LLR "
+                     <<std::setprecision(2)<<rule.getLlr(w)<<")\n";
+            break;
+        default:
+            std::cout<<"Stopped: sample limit reached, the rule was not met\n";
+    }
+}
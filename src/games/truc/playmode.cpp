@@ -0,0 +1,21 @@
+#include "headers/truc.h"
+#include "headers/botdecider.h"
+#include "headers/game.h"
+
+// Plays blackjack through the menus, or straight away at full speed when
+// `strategy` or `script` (which goes first) plays instead of a human
+int play(uint64_t seed, long long rounds, const StrategyTable *strategy, Decider *script){
+    BotDecider bot(strategy, NULL, rounds);
+
+    Game game(seed);            // Constructs object GAME
+    if(strategy!=NULL || script!=NULL){
+        // No human seated: play straight away at full speed
+        game.setName(script==NULL ? "Bot" : "Script");
+        game.setDecider(script==NULL ? (Decider*)&bot : script);
+        game.beginGame();
+        return 0;
+    }
+    game.beginMenu(false, "");  // Begins with the interface
+
+    return 0;
+}
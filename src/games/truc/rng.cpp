@@ -0,0 +1,96 @@
+#include "headers/rng.h"
+
+static const uint32_t PHILOX_M0 = 0xD2511F53;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57;
+static const uint32_t PHILOX_W0 = 0x9E3779B9;
+static const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+//////////////* Constructors *////
+
+Rng::Rng(){
+    setSeed(0, 0);
+}
+
+Rng::Rng(uint64_t seed, uint64_t table){
+    setSeed(seed, table);
+}
+
+// Selects the stream of a table and rewinds it to hand 0
+void Rng::setSeed(uint64_t seed, uint64_t table){
+    key[0] = (uint32_t)seed;
+    key[1] = (uint32_t)(seed>>32);
+    counter[3] = (uint32_t)table;
+    setHand(0);
+}
+
+//////////////* Stream Positioning *////
+
+// Jumps to the first output of a hand
+void Rng::setHand(uint64_t hand){
+    counter[0] = 0;
+    counter[1] = (uint32_t)hand;
+    counter[2] = (uint32_t)(hand>>32);
+    used = 4;
+}
+
+// Skips ahead a number of 4-word blocks within the current hand
+void Rng::jump(uint64_t blocks){
+    counter[0] += (uint32_t)blocks;
+    used = 4;
+}
+
+//////////////* Outputs *////
+
+void Rng::refill(){
+    philox(counter, key, out);
+    counter[0]++;
+    used = 0;
+}
+
+// Next uniformly distributed 32-bit word
+uint32_t Rng::next(){
+    if(used==4){
+        refill();
+    }
+    return out[used++];
+}
+
+// Uniform integer in [0, n) without modulo bias (Lemire's method)
+uint32_t Rng::below(uint32_t n){
+    uint64_t m = (uint64_t)next()*n;
+    uint32_t l = (uint32_t)m;
+    if(l<n){
+        uint32_t t = (0u-n)%n;
+        while(l<t){
+            m = (uint64_t)next()*n;
+            l = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m>>32);
+}
+
+// Uniform double in [0, 1)
+double Rng::uniform(){
+    return (next()>>5)*(1.0/134217728.0);
+}
+
+//////////////* Philox4x32-10 *////
+
+void Rng::philox(const uint32_t ctr[4], const uint32_t k[2], uint32_t result[4]){
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    uint32_t k0 = k[0], k1 = k[1];
+    for(int i=0;i<10;i++){
+        uint64_t p0 = (uint64_t)PHILOX_M0*c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1*c2;
+        c0 = (uint32_t)(p1>>32)^c1^k0;
+        c1 = (uint32_t)p1;
+        c2 = (uint32_t)(p0>>32)^c3^k1;
+        c3 = (uint32_t)p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    result[0] = c0;
+    result[1] = c1;
+    result[2] = c2;
+    result[3] = c3;
+}
@@ -0,0 +1,99 @@
+#include "headers/scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+int64_t Scheduler::now(){
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//////////////* Timers *////
+
+// Calls w->expire(id) once, ms from now
+uint64_t Scheduler::addTimer(int ms, Waker *w){
+    Timer t = {now()+ms, nextTimer++};
+    timers.push_back(t);
+    std::push_heap(timers.begin(), timers.end(), std::greater<Timer>());
+    armed[t.id] = w;
+    return t.id;
+}
+
+// Cancelled timers stay in the heap until they reach the top, unless they
+// outnumber the armed ones: then the heap is rebuilt without them
+void Scheduler::cancelTimer(uint64_t id){
+    armed.erase(id);
+    if(timers.size()>2*armed.size()+1024){
+        compact();
+    }
+}
+
+void Scheduler::compact(){
+    timers.erase(std::remove_if(timers.begin(), timers.end(), [this](const Timer &t){ return armed.find(t.id)==armed.end(); }), timers.end());
+    std::make_heap(timers.begin(), timers.end(), std::greater<Timer>());
+}
+
+// Expires every timer that is due; cancelled ones are dropped on the way
+int Scheduler::fireTimers(){
+    int fired = 0;
+    int64_t t = now();
+    while(!timers.empty() && timers.front().deadline<=t){
+        uint64_t id = timers.front().id;
+        std::pop_heap(timers.begin(), timers.end(), std::greater<Timer>());
+        timers.pop_back();
+        auto it = armed.find(id);
+        if(it==armed.end()){
+            continue;
+        }
+        Waker *w = it->second;
+        armed.erase(it);
+        w->expire(id);
+        fired++;
+    }
+    // nextTimeout() reads the top: keep it armed
+    while(!timers.empty() && armed.find(timers.front().id)==armed.end()){
+        std::pop_heap(timers.begin(), timers.end(), std::greater<Timer>());
+        timers.pop_back();
+    }
+    return fired;
+}
+
+// Milliseconds an event loop may wait: 0 with work ready, -1 with nothing armed
+int Scheduler::nextTimeout() const {
+    if(!ready.empty()){
+        return 0;
+    }
+    if(armed.empty()){
+        return -1;
+    }
+    int64_t wait = timers.front().deadline-now();
+    return wait>0 ? (int)wait : 0;
+}
+
+//////////////* Running *////
+
+// Resumes ready coroutines, including those they make ready, until none is left
+long long Scheduler::runReady(){
+    long long n = 0;
+    while(!ready.empty()){
+        std::coroutine_handle<> h = ready.front();
+        ready.pop_front();
+        h.resume();
+        n++;
+    }
+    return n;
+}
+
+// Runs until nothing is ready and no timer is armed
+void Scheduler::run(){
+    while(true){
+        runReady();
+        fireTimers();
+        if(!ready.empty()){
+            continue;
+        }
+        if(armed.empty()){
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(nextTimeout()));
+    }
+}
@@ -0,0 +1,93 @@
+#include "headers/screen.h"
+#include <iostream>
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+//////////////* Constructor *////
+
+Screen::Screen(): stream(&buffer){
+    buffer.frame = &frame;
+    full = true;
+}
+
+//////////////* Composing *////
+
+// Starts a new frame and returns the stream to write it
+std::ostream& Screen::begin(){
+    frame.clear();
+    return stream;
+}
+
+// Cuts the frame in rows. A row that starts in the middle of a colour gets
+// that colour's escape sequence in front, so it can be redrawn on its own.
+void Screen::split(){
+    rows.clear();
+    std::string colour;
+    size_t start = 0;
+    while(true){
+        size_t end = frame.find('\n', start);
+        std::string row = frame.substr(start, end==std::string::npos ? std::string::npos : end-start);
+        rows.push_back(colour+row);
+        for(size_t e=row.find("\033[");e!=std::string::npos;e=row.find("\033[", e+1)){
+            size_t m = row.find('m', e);
+            if(m!=std::string::npos){
+                colour = row.substr(e, m-e+1);
+            }
+        }
+        if(end==std::string::npos){
+            break;
+        }
+        start = end+1;
+    }
+}
+
+// Rows of the terminal, 0 if unknown
+int Screen::height(){
+#ifndef _WIN32
+    struct winsize w;
+    if(ioctl(STDOUT_FILENO, TIOCGWINSZ, &w)==0){
+        return w.ws_row;
+    }
+#endif
+    return 0;
+}
+
+//////////////* Output *////
+
+// Sends the frame. The last row of the previous frame is always redrawn,
+// because the echo of the answer to its prompt lands there.
+void Screen::present(){
+    std::cout.flush();
+    split();
+    int h = height();
+    output.clear();
+    if(full || previous.empty() || (h>0 && (rows.size()>(size_t)h || previous.size()>(size_t)h))){
+        output += "\033[H\033[2J";
+        output += frame;
+    }
+    else{
+        for(size_t r=0;r+1<rows.size();r++){
+            if(r+1>=previous.size() || rows[r]!=previous[r]){
+                output += "\033["+std::to_string(r+1)+";1H"+rows[r]+"\033[K";
+            }
+        }
+        output += "\033["+std::to_string(rows.size())+";1H"+rows.back()+"\033[J";
+    }
+#ifdef _WIN32
+    std::cout.write(output.data(), output.size());
+    std::cout.flush();
+#else
+    size_t done = 0;
+    while(done<output.size()){
+        ssize_t n = write(STDOUT_FILENO, output.data()+done, output.size()-done);
+        if(n<=0){
+            break;
+        }
+        done += n;
+    }
+#endif
+    previous.swap(rows);
+    full = false;
+}
@@ -0,0 +1,109 @@
+#include "headers/scripteddecider.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+//////////////* Constructor & Loading *////
+
+ScriptedDecider::ScriptedDecider(){
+    next = 0;
+    betTarget = -1;
+}
+
+bool ScriptedDecider::load(const std::string &path){
+    std::ifstream f1(path);
+    if(f1.fail()){
+        return false;
+    }
+    tokens.clear();
+    next = 0;
+    std::string line, token;
+    while(std::getline(f1, line)){
+        std::istringstream in(line.substr(0, line.find('#')));
+        while(in>>token){
+            tokens.push_back(token);
+        }
+    }
+    return true;
+}
+
+// Next token, false when the script is over
+bool ScriptedDecider::take(std::string &token){
+    if(next>=tokens.size()){
+        return false;
+    }
+    token = tokens[next++];
+    return true;
+}
+
+// Ends the script when a token can't answer the decision asked for
+bool ScriptedDecider::stop(){
+    next = tokens.size();
+    return false;
+}
+
+//////////////* Blackjack *////
+
+int ScriptedDecider::chooseBet(int cash, int bet, int cardsLeft){
+    if(betTarget<0){
+        std::string token;
+        char *end = NULL;
+        long amount = take(token) ? strtol(token.c_str(), &end, 10) : -1;
+        if(end==NULL || *end!='\0' || amount<0){
+            stop();
+            return BET_DONE;
+        }
+        betTarget = amount/5*5;
+    }
+    if(bet<betTarget && cash>=5){
+        return BET_RAISE;
+    }
+    if(bet>betTarget){
+        return BET_LOWER;
+    }
+    betTarget = -1;
+    return BET_DONE;
+}
+
+bool ScriptedDecider::chooseHit(const Hand &player, Card up){
+    std::string token;
+    if(!take(token)){
+        return false;
+    }
+    if(token=="H" || token=="h"){
+        return true;
+    }
+    if(token=="S" || token=="s"){
+        return false;
+    }
+    return stop();
+}
+
+bool ScriptedDecider::keepPlaying(){
+    std::string token;
+    if(!take(token)){
+        return false;
+    }
+    if(token=="Y" || token=="y"){
+        return true;
+    }
+    return token=="N" || token=="n" ? false : stop();
+}
+
+//////////////* Truc *////
+
+uint8_t ScriptedDecider::chooseTrucMove(const TrucState &s){
+    static const char *names[TrucState::MOVES] = {"1", "2", "3", "truc", "envit", "falta", "vull", "novull"};
+    uint8_t moves[TrucState::MOVES];
+    int n = s.legalMoves(moves);
+    std::string token;
+    if(take(token)){
+        for(int i=0;i<n;i++){
+            if(token==names[moves[i]]){
+                return moves[i];
+            }
+        }
+        stop();
+    }
+    return moves[0];
+}
@@ -0,0 +1,23 @@
+#include "headers/seat.h"
+
+// Translates the Decider's answer for the table's phase into an action
+void DeciderSeat::ask(const Table &t){
+    switch(t.getPhase()){
+        case Table::BETTING:
+            switch(decider->chooseBet(t.getCash(), t.getBet(), t.getCardsLeft())){
+                case Decider::BET_RAISE: action.resolve(Table::RAISE); break;
+                case Decider::BET_LOWER: action.resolve(Table::LOWER); break;
+                case Decider::BET_DONE: action.resolve(Table::DEAL); break;
+                default: action.resolve(Table::NONE);
+            }
+            break;
+        case Table::PLAYING:
+            action.resolve(decider->chooseHit(t.getPlayer(), t.getDealer().getCard(0)) ? Table::HIT : Table::STAND);
+            break;
+        case Table::OVER:
+            action.resolve(decider->keepPlaying() ? Table::NEXT : Table::LEAVE);
+            break;
+        default:
+            action.resolve(Table::LEAVE);
+    }
+}
@@ -0,0 +1,307 @@
+#include "headers/selftest.h"
+#include "headers/handbatch.h"
+#include "headers/protocol.h"
+#include "headers/rng.h"
+#include "headers/rules.h"
+#include "headers/server.h"
+#include "headers/solver.h"
+#include <cmath>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+//////////////* Hand Batch *////
+
+// Evaluates `hands` with kernel k and compares every total and flag with Hand
+static bool sameAsHand(const std::vector<Hand> &hands, HandBatch::Kernel k){
+    HandBatch batch(hands.size());
+    for(const Hand &h: hands){
+        batch.add(h);
+    }
+    batch.evaluate(k);
+    for(size_t i=0;i<hands.size();i++){
+        const Hand &h = hands[i];
+        uint8_t flags = (h.isSoft() ? HandBatch::SOFT : 0) | (h.getSum()>21 ? HandBatch::BUST : 0) |
+                        (h.getSize()==2 && h.getSum()==21 ? HandBatch::BLACKJACK : 0);
+        if(batch.getTotal(i)!=h.getSum() || batch.getFlags(i)!=flags){
+            return false;
+        }
+    }
+    return true;
+}
+
+// Every kernel against Hand::getSum()/isSoft(): every hand of up to 3 cards,
+// every run of aces with up to 2 more cards (the soft/hard edges), and
+// random hands of every size, in batches that also leave a scalar tail
+bool SelfTest::handBatch(std::ostream &out, uint64_t seed){
+    std::vector<Hand> edges, random;
+    for(int a=1;a<=13;a++){
+        for(int b=0;b<=13;b++){
+            for(int c=0;c<=(b>0 ? 13 : 0);c++){
+                Hand h;
+                h.addCard(Card(a, 'O'));
+                if(b>0) h.addCard(Card(b, 'E'));
+                if(c>0) h.addCard(Card(c, 'B'));
+                edges.push_back(h);
+            }
+        }
+    }
+    for(int aces=1;aces<Hand::MAX_CARDS;aces++){
+        for(int b=0;b<=13;b++){
+            for(int c=0;c<=(b>0 && aces+2<=Hand::MAX_CARDS ? 13 : 0);c++){
+                Hand h;
+                for(int i=0;i<aces;i++){
+                    h.addCard(Card(1, CardTable::SUITS[i%4]));
+                }
+                if(b>0) h.addCard(Card(b, 'C'));
+                if(c>0) h.addCard(Card(c, 'O'));
+                edges.push_back(h);
+            }
+        }
+    }
+    Rng rng(seed, 0);
+    for(int i=0;i<100000+17;i++){
+        Hand h;
+        int size = 1+rng.below(Hand::MAX_CARDS);
+        for(int j=0;j<size;j++){
+            h.addCard(Card(1+rng.below(13), CardTable::SUITS[rng.below(4)]));
+        }
+        random.push_back(h);
+    }
+    const HandBatch::Kernel kernels[3] = {HandBatch::SCALAR, HandBatch::SSE2, HandBatch::AVX2};
+    const char *names[3] = {"scalar", "SSE2", "AVX2"};
+    bool passed = true;
+    for(int k=0;k<3;k++){
+        if(!HandBatch::supports(kernels[k])){
+            out<<"HandBatch "<<names[k]<<": not supported here, skipped\n";
+            continue;
+        }
+        bool ok = sameAsHand(edges, kernels[k]) && sameAsHand(random, kernels[k]);
+        out<<"HandBatch "<<names[k]<<": "<<edges.size()<<" edge and "<<random.size()<<" random hands "
+           <<(ok ? "match Hand" : "DIFFER from Hand")<<"\n";
+        passed = passed && ok;
+    }
+    return passed;
+}
+
+//////////////* Solver *////
+
+// Cards left by value index (0 = aces, 9 = tens), as in Composition
+struct Cards{
+    int count[10];
+    int total;
+    // Draws value index v and returns its odds
+    double take(int v){ double p = (double)count[v]/total; count[v]--; total--; return p; }
+    void putBack(int v){ count[v]++; total++; }
+};
+
+// The player stood on `total`: the dealer, holding (hard, ace), draws card by
+// card while behind and under 17. Returns the player's EV.
+static double dealerRun(int hard, bool ace, int total, Cards &left, bool playing){
+    int sum = Solver::getTotal(hard, ace);
+    if(!playing && !Rules::dealerPlays(sum, total)){
+        switch(Rules::compareSum(sum, total)){
+            case 'p': return 1.0;
+            case 'd': return -1.0;
+        }
+        return 0.0;
+    }
+    if(sum>Rules::BLACKJACK || !Rules::dealerDraws(sum)){
+        char result = Rules::checkEnd(sum, total);
+        if(result=='f'){
+            result = Rules::compareSum(sum, total);
+        }
+        return result=='p' ? 1.0 : result=='d' ? -1.0 : 0.0;
+    }
+    double ev = 0.0;
+    for(int v=0;v<10;v++){
+        if(left.count[v]==0) continue;
+        double p = left.take(v);
+        ev += p*dealerRun(hard+v+1, ace || v==0, total, left, true);
+        left.putBack(v);
+    }
+    return ev;
+}
+
+// EV of the (hard, ace) cell against `up` from a fresh deck, dealing every
+// two-card hand, then every hole card but the ones making the dealer 21,
+// then either standing or taking one card and standing. Shares nothing with
+// Solver but getTotal(), so it checks both the recursion and where the
+// no-dealer-21 condition is applied.
+static double enumerateCell(int hard, bool ace, int up, bool hitOnce){
+    Cards left;
+    for(int v=0;v<10;v++){
+        left.count[v] = v==9 ? 16 : 4;
+    }
+    left.total = 52;
+    left.take(up-1);
+    double ev = 0.0, odds = 0.0;
+    for(int a=0;a<10;a++){
+        if(left.count[a]==0) continue;
+        double pa = left.take(a);
+        for(int b=0;b<10;b++){
+            if(left.count[b]==0) continue;
+            double pb = pa*left.take(b);
+            int h = a+b+2;
+            bool soft = a==0 || b==0;
+            if(h==hard && soft==ace && Solver::getTotal(h, soft)<Rules::BLACKJACK){
+                for(int v=0;v<10;v++){
+                    if(left.count[v]==0) continue;
+                    double p = pb*left.take(v);
+                    if(Solver::getTotal(up+v+1, up==1 || v==0)!=Rules::BLACKJACK){
+                        odds += p;
+                        double sub = 0.0;
+                        if(!hitOnce){
+                            sub = dealerRun(up+v+1, up==1 || v==0, Solver::getTotal(h, soft), left, false);
+                        }
+                        else{
+                            for(int d=0;d<10;d++){
+                                if(left.count[d]==0) continue;
+                                double pd = left.take(d);
+                                int total = Solver::getTotal(h+d+1, soft || d==0);
+                                sub += pd*(total>Rules::BLACKJACK ? -1.0 : total==Rules::BLACKJACK ? 1.0 :
+                                           dealerRun(up+v+1, up==1 || v==0, total, left, false));
+                                left.putBack(d);
+                            }
+                        }
+                        ev += p*sub;
+                    }
+                    left.putBack(v);
+                }
+            }
+            left.putBack(b);
+        }
+        left.putBack(a);
+    }
+    return odds>0 ? ev/odds : 0.0;
+}
+
+// 1-deck solver values against enumerateCell() for the up-cards that can
+// hide a dealer 21 and one that can't: standing on every cell, and hitting
+// hard 19 and 20, where the only sensible play after the card is to stand
+bool SelfTest::solverExact(std::ostream &out){
+    Solver solver(Composition::decks(1));
+    solver.solve(1);
+    const int ups[3] = {1, 6, 10};
+    int cells = 0;
+    double worst = 0.0;
+    for(int up: ups){
+        for(int hard=2;hard<=20;hard++){
+            for(int ace=0;ace<2;ace++){
+                if(ace ? hard>10 : hard<4) continue;
+                double d = std::fabs(solver.getStand(hard, ace, up)-enumerateCell(hard, ace, up, false));
+                worst = d>worst ? d : worst;
+                cells++;
+            }
+        }
+        for(int hard=19;hard<=20;hard++){
+            double d = std::fabs(solver.getHit(hard, false, up)-enumerateCell(hard, false, up, true));
+            worst = d>worst ? d : worst;
+            cells++;
+        }
+    }
+    bool ok = worst<1e-9;
+    out<<"Solver 1 deck: "<<cells<<" cells against full enumeration "
+       <<(ok ? "match" : "DIFFER")<<" (worst "<<worst<<")\n";
+    return ok;
+}
+
+//////////////* Server Frames *////
+
+// Sends `frame` on a new connection and reads until a whole frame or the end
+// of the connection: the reply's type, 0 when the server closed, -1 when
+// nothing came within 2 s
+static int replyTo(const std::string &address, const std::string &frame){
+    int fd = Server::connect(address);
+    if(fd<0){
+        return -1;
+    }
+    int type = -1;
+    std::string in;
+    if(send(fd, frame.data(), frame.size(), MSG_NOSIGNAL)==(ssize_t)frame.size()){
+        struct pollfd p = {fd, POLLIN, 0};
+        while(type<0 && poll(&p, 1, 2000)>0){
+            char buf[512];
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if(n<=0){
+                type = 0;
+                break;
+            }
+            in.append(buf, n);
+            if(Protocol::frameSize(in, 0)>=2){
+                type = (uint8_t)in[1];
+            }
+        }
+    }
+    close(fd);
+    return type;
+}
+
+// Sends `frames` on a new connection and shuts down the sending side: the
+// STATE frames received before the server closed, -1 if it didn't within 2 s
+static int answersBeforeClose(const std::string &address, const std::string &frames){
+    int fd = Server::connect(address);
+    if(fd<0){
+        return -1;
+    }
+    int states = -1;
+    std::string in;
+    if(send(fd, frames.data(), frames.size(), MSG_NOSIGNAL)==(ssize_t)frames.size() && shutdown(fd, SHUT_WR)==0){
+        struct pollfd p = {fd, POLLIN, 0};
+        while(poll(&p, 1, 2000)>0){
+            char buf[512];
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if(n<=0){
+                states = 0;
+                int size;
+                for(size_t at=0;(size = Protocol::frameSize(in, at))>=2;at+=size){
+                    states += (uint8_t)in[at+1]==Protocol::STATE;
+                }
+                break;
+            }
+            in.append(buf, n);
+        }
+    }
+    close(fd);
+    return states;
+}
+
+// A frame of length 0, alone or followed by a type byte, closes its session
+// and leaves the server serving; a JOIN without a name is answered, and so
+// are frames sent just before the client shuts down its side
+bool SelfTest::serverFrames(std::ostream &out, uint64_t seed){
+    std::string address = "unix:/tmp/truc-selftest-"+std::to_string(getpid());
+    Server server(seed, 0);
+    if(!server.listen(address)){
+        out<<"Server frames: could not listen on "<<address<<", skipped\n";
+        return true;
+    }
+    std::thread serving(&Server::run, &server, 1);
+    std::string join;
+    Protocol::frame(join, Protocol::JOIN);
+    // The first answer also means the workers are up for stop()
+    bool ok = replyTo(address, join)==Protocol::STATE;
+    ok = replyTo(address, std::string(1, '\0'))==0 && ok;
+    ok = replyTo(address, std::string("\0\1", 2))==0 && ok;
+    ok = replyTo(address, join)==Protocol::STATE && ok;
+    std::string twoFrames = join;
+    Protocol::frame(twoFrames, Protocol::RAISE);
+    ok = answersBeforeClose(address, twoFrames)==2 && ok;
+    server.stop();
+    serving.join();
+    out<<"Server frames: zero-length frames, an empty JOIN and a half-close "<<(ok ? "handled" : "NOT handled")<<"\n";
+    return ok;
+}
+
+//////////////* Runner *////
+
+int SelfTest::run(std::ostream &out, uint64_t seed){
+    int failed = 0;
+    failed += !handBatch(out, seed);
+    failed += !solverExact(out);
+    failed += !serverFrames(out, seed);
+    out<<(failed==0 ? "All checks passed" : "Some checks FAILED")<<"\n";
+    return failed;
+}
@@ -0,0 +1,99 @@
+#include "headers/sequential.h"
+#include <cmath>
+
+//////////////* Welford *////
+
+Welford::Welford(){
+    n = 0;
+    mean = 0.0;
+    m2 = 0.0;
+}
+
+// From the count, sum and sum of squares of integer samples, which are exact
+Welford::Welford(long long count, double sum, double sumSq){
+    n = count;
+    mean = count>0 ? sum/count : 0.0;
+    m2 = count>0 ? sumSq-sum*mean : 0.0;
+}
+
+void Welford::add(double x){
+    n++;
+    double delta = x-mean;
+    mean += delta/n;
+    m2 += delta*(x-mean);
+}
+
+void Welford::merge(const Welford &w){
+    if(w.n==0){
+        return;
+    }
+    long long total = n+w.n;
+    double delta = w.mean-mean;
+    mean += delta*w.n/total;
+    m2 += w.m2+delta*delta*((double)n*w.n/total);
+    n = total;
+}
+
+// Sample variance
+double Welford::getVariance() const{
+    return n>1 ? m2/(n-1) : 0.0;
+}
+
+// Standard error of the mean
+double Welford::getStdError() const{
+    return n>1 ? std::sqrt(getVariance()/n) : 0.0;
+}
+
+//////////////* Stopping Rule *////
+
+StoppingRule::StoppingRule(){
+    halfWidth = 0.0;
+    sprt = false;
+    m0 = 0.0;
+    m1 = 0.0;
+    lower = 0.0;
+    upper = 0.0;
+}
+
+// Stops once 1.96 standard errors are at most h
+void StoppingRule::setPrecision(double h){
+    halfWidth = h;
+}
+
+// Decides between mean0 and mean1, wrongly taking mean1 with probability
+// alpha and wrongly taking mean0 with probability beta
+void StoppingRule::setSprt(double mean0, double mean1, double alpha, double beta){
+    sprt = true;
+    m0 = mean0;
+    m1 = mean1;
+    lower = std::log(beta/(1.0-alpha));
+    upper = std::log((1.0-beta)/alpha);
+}
+
+// Log-likelihood ratio of m1 against m0 for normal samples
+double StoppingRule::getLlr(const Welford &w) const{
+    double variance = w.getVariance();
+    if(variance<=0.0){
+        return 0.0;
+    }
+    return (m1-m0)/variance*w.n*(w.mean-(m0+m1)/2);
+}
+
+StoppingRule::Verdict StoppingRule::check(const Welford &w) const{
+    if(w.n<MIN_SAMPLES){
+        return CONTINUE;
+    }
+    if(sprt){
+        double llr = getLlr(w);
+        if(llr>=upper){
+            return ACCEPT_M1;
+        }
+        if(llr<=lower){
+            return ACCEPT_M0;
+        }
+    }
+    if(halfWidth>0 && 1.96*w.getStdError()<=halfWidth){
+        return PRECISE;
+    }
+    return CONTINUE;
+}
@@ -0,0 +1,27 @@
+#include "headers/truc.h"
+#include "headers/server.h"
+#include <csignal>
+#include <iostream>
+
+static Server *running = NULL;     // Server stopped by SIGINT/SIGTERM
+
+static void stopServer(int sig){
+    running->stop();
+}
+
+// Hosts tables on `address` until interrupted
+int serve(const std::string &address, int threads, int idleMs, uint64_t seed){
+    Server server(seed, idleMs);
+    if(!server.listen(address)){
+        std::cerr<<"Could not listen on "<<address<<"\n";
+        return 1;
+    }
+    running = &server;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+    signal(SIGPIPE, SIG_IGN);
+    std::cout<<"Serving tables on "<<address<<" with "<<threads<<" workers\n"<<std::flush;
+    server.run(threads);
+    std::cout<<"\n"<<server.getSessions()<<" sessions, "<<server.getRequests()<<" requests served\n";
+    return 0;
+}
@@ -0,0 +1,469 @@
+#include "headers/server.h"
+#include "headers/protocol.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//////////////* Addresses *////
+
+// Socket address for "unix:PATH", "HOST:PORT" or "PORT"
+static bool resolve(const std::string &address, sockaddr_storage &addr, socklen_t &size){
+    memset(&addr, 0, sizeof(addr));
+    if(address.compare(0, 5, "unix:")==0){
+        sockaddr_un *un = (sockaddr_un*)&addr;
+        std::string path = address.substr(5);
+        if(path.empty() || path.size()>=sizeof(un->sun_path)){
+            return false;
+        }
+        un->sun_family = AF_UNIX;
+        memcpy(un->sun_path, path.c_str(), path.size()+1);
+        size = sizeof(sockaddr_un);
+        return true;
+    }
+    size_t colon = address.rfind(':');
+    std::string host = colon==std::string::npos ? "" : address.substr(0, colon);
+    std::string port = colon==std::string::npos ? address : address.substr(colon+1);
+    addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    if(getaddrinfo(host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &res)!=0){
+        return false;
+    }
+    memcpy(&addr, res->ai_addr, res->ai_addrlen);
+    size = res->ai_addrlen;
+    freeaddrinfo(res);
+    return true;
+}
+
+static void setNonBlocking(int fd){
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL)|O_NONBLOCK);
+}
+
+// Writes all of `out` to a non-blocking socket, waiting while it's full
+static bool sendAll(int fd, const std::string &out){
+    size_t sent = 0;
+    while(sent<out.size()){
+        ssize_t n = write(fd, out.data()+sent, out.size()-sent);
+        if(n<0){
+            if(errno==EAGAIN || errno==EWOULDBLOCK){
+                struct pollfd p = {fd, POLLOUT, 0};
+                ::poll(&p, 1, -1);
+            }
+            else if(errno!=EINTR){
+                return false;
+            }
+            continue;
+        }
+        sent += n;
+    }
+    return true;
+}
+
+//////////////* Constructor and Destructor *////
+
+Server::Server(uint64_t s, int idle){
+    listener = -1;
+    seed = s;
+    idleMs = idle;
+}
+
+Server::~Server(){
+    if(listener>=0){
+        ::close(listener);
+    }
+    if(!unixPath.empty()){
+        unlink(unixPath.c_str());
+    }
+}
+
+//////////////* Set Up *////
+
+bool Server::listen(const std::string &address){
+    sockaddr_storage addr;
+    socklen_t size;
+    if(!resolve(address, addr, size)){
+        return false;
+    }
+    listener = socket(addr.ss_family, SOCK_STREAM|SOCK_NONBLOCK|SOCK_CLOEXEC, 0);
+    if(listener<0){
+        return false;
+    }
+    if(addr.ss_family==AF_UNIX){
+        unixPath = ((sockaddr_un*)&addr)->sun_path;
+        unlink(unixPath.c_str());
+    }
+    else{
+        int on = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    }
+    return bind(listener, (sockaddr*)&addr, size)==0 && ::listen(listener, SOMAXCONN)==0;
+}
+
+// Serves on `threads` workers until stop()
+void Server::run(int threads){
+    workers.resize(threads);
+    for(int i=0;i<threads;i++){
+        Worker &w = workers[i];
+        w.epoll = epoll_create1(EPOLL_CLOEXEC);
+        w.wake = eventfd(0, EFD_NONBLOCK|EFD_CLOEXEC);
+        w.nextId = i;
+        w.sessions = 0;
+        w.requests = 0;
+        epoll_event e;
+        e.events = EPOLLIN|EPOLLEXCLUSIVE;
+        e.data.ptr = NULL;
+        epoll_ctl(w.epoll, EPOLL_CTL_ADD, listener, &e);
+        e.events = EPOLLIN;
+        e.data.ptr = &w;
+        epoll_ctl(w.epoll, EPOLL_CTL_ADD, w.wake, &e);
+    }
+    for(int i=1;i<threads;i++){
+        workers[i].thread = std::thread(&Server::runWorker, this, std::ref(workers[i]));
+    }
+    runWorker(workers[0]);
+    for(int i=1;i<threads;i++){
+        workers[i].thread.join();
+    }
+    for(Worker &w: workers){
+        for(Session *s: w.open){
+            if(s!=NULL){
+                close(w, s);
+            }
+        }
+        ::close(w.epoll);
+        ::close(w.wake);
+    }
+}
+
+// Only writes to the workers' eventfds, so a signal handler may call it
+void Server::stop(){
+    uint64_t one = 1;
+    for(Worker &w: workers){
+        if(write(w.wake, &one, sizeof(one))<0){
+            continue;
+        }
+    }
+}
+
+long long Server::getSessions() const {
+    long long n = 0;
+    for(const Worker &w: workers){
+        n += w.sessions;
+    }
+    return n;
+}
+
+long long Server::getRequests() const {
+    long long n = 0;
+    for(const Worker &w: workers){
+        n += w.requests;
+    }
+    return n;
+}
+
+//////////////* Event Loop *////
+
+void Server::runWorker(Worker &w){
+    epoll_event events[64];
+    while(true){
+        int n = epoll_wait(w.epoll, events, 64, w.scheduler.nextTimeout());
+        if(n<0 && errno!=EINTR){
+            return;
+        }
+        for(int i=0;i<n;i++){
+            void *ptr = events[i].data.ptr;
+            if(ptr==NULL){
+                accept(w);
+            }
+            else if(ptr==&w){
+                return;
+            }
+            else{
+                Session *s = (Session*)ptr;
+                bool alive = !(events[i].events & (EPOLLERR|EPOLLHUP));
+                if(alive && (events[i].events & EPOLLIN)){
+                    alive = receive(w, *s);
+                }
+                if(alive){
+                    alive = flush(w, *s);
+                }
+                if(!alive){
+                    close(w, s);
+                }
+            }
+        }
+        // Idle players: the tables play for them
+        w.scheduler.fireTimers();
+        w.scheduler.runReady();
+        for(Session *s: w.idle){
+            close(w, s);
+        }
+        w.idle.clear();
+    }
+}
+
+// Plays the session's table; a table that lets its player go is closed
+// once the scheduler is done running
+Task<void> Server::host(Worker &w, Session *s){
+    co_await s->table.play(s->seat, w.scheduler, idleMs);
+    if(s->table.getPhase()!=Table::BANKRUPT){
+        w.idle.push_back(s);
+    }
+}
+
+// Takes every pending connection; another worker may have been faster
+void Server::accept(Worker &w){
+    while(true){
+        int fd = accept4(listener, NULL, NULL, SOCK_NONBLOCK|SOCK_CLOEXEC);
+        if(fd<0){
+            return;
+        }
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        Session *s = new Session(fd, seed, w.nextId);
+        w.nextId += workers.size();
+        w.sessions++;
+        if((size_t)fd>=w.open.size()){
+            w.open.resize(fd+1, NULL);
+        }
+        w.open[fd] = s;
+        epoll_event e;
+        e.events = EPOLLIN|EPOLLRDHUP;
+        e.data.ptr = s;
+        epoll_ctl(w.epoll, EPOLL_CTL_ADD, fd, &e);
+    }
+}
+
+// Reads what arrived and answers every whole frame; false to close at once,
+// on a read error or a malformed frame. After the end of the input or a
+// LEAVE the frames before it are still answered, and flush() closes the
+// session once the replies are sent. Each action resumes the table's
+// coroutine, which runs until it waits again before the state is sent, so
+// the scheduler's queue is always empty here.
+bool Server::receive(Worker &w, Session &s){
+    char buf[4096];
+    while(!s.closing){
+        ssize_t n = read(s.fd, buf, sizeof(buf));
+        if(n==0){
+            s.closing = true;
+            break;
+        }
+        if(n<0){
+            if(errno==EAGAIN || errno==EWOULDBLOCK){
+                break;
+            }
+            if(errno==EINTR){
+                continue;
+            }
+            return false;
+        }
+        s.in.append(buf, n);
+    }
+    size_t at = 0;
+    int size;
+    while((size = Protocol::frameSize(s.in, at))>0){
+        if(size<2){
+            return false;
+        }
+        const char *f = s.in.data()+at;
+        Table &t = s.table;
+        uint8_t type = f[1];
+        if(type==Protocol::LEAVE){
+            s.closing = true;
+            s.in.clear();
+            return true;
+        }
+        if(type==Protocol::JOIN){
+            t.setName(std::string(f+2, size>2 ? (size-2<Protocol::MAX_NAME ? size-2 : Protocol::MAX_NAME) : 0));
+        }
+        if(s.game.getHandle()==nullptr){
+            s.game = host(w, &s);
+            w.scheduler.start(s.game);
+        }
+        switch(type){
+            case Protocol::RAISE: s.seat.action.resolve(Table::RAISE); break;
+            case Protocol::LOWER: s.seat.action.resolve(Table::LOWER); break;
+            case Protocol::DEAL: s.seat.action.resolve(Table::DEAL); break;
+            case Protocol::HIT: s.seat.action.resolve(Table::HIT); break;
+            case Protocol::STAND: s.seat.action.resolve(Table::STAND); break;
+            case Protocol::NEXT: s.seat.action.resolve(Table::NEXT); break;
+        }
+        w.scheduler.runReady();
+        Protocol::state(s.out, t);
+        w.requests++;
+        at += size;
+    }
+    if(size<0){
+        return false;
+    }
+    s.in.erase(0, at);
+    return true;
+}
+
+// Sends pending replies, waiting for EPOLLOUT when the socket is full; false
+// to close, on an error or once a closing session has sent everything
+bool Server::flush(Worker &w, Session &s){
+    size_t sent = 0;
+    while(sent<s.out.size()){
+        ssize_t n = write(s.fd, s.out.data()+sent, s.out.size()-sent);
+        if(n<0){
+            if(errno==EINTR){
+                continue;
+            }
+            if(errno!=EAGAIN && errno!=EWOULDBLOCK){
+                return false;
+            }
+            break;
+        }
+        sent += n;
+    }
+    s.out.erase(0, sent);
+    if(s.out.size()>MAX_PENDING){
+        return false;
+    }
+    if(s.closing && s.out.empty()){
+        return false;
+    }
+    // A closing session only waits to write, its end of input would wake it forever
+    bool waiting = !s.out.empty();
+    if(waiting!=s.writing || s.closing){
+        epoll_event e;
+        e.events = (s.closing ? 0 : EPOLLIN|EPOLLRDHUP)|(waiting ? EPOLLOUT : 0);
+        e.data.ptr = &s;
+        epoll_ctl(w.epoll, EPOLL_CTL_MOD, s.fd, &e);
+        s.writing = waiting;
+    }
+    return true;
+}
+
+void Server::close(Worker &w, Session *s){
+    epoll_ctl(w.epoll, EPOLL_CTL_DEL, s->fd, NULL);
+    ::close(s->fd);
+    w.open[s->fd] = NULL;
+    delete s;
+}
+
+//////////////* Clients *////
+
+// Blocking connection to a server, -1 on failure
+int Server::connect(const std::string &address){
+    sockaddr_storage addr;
+    socklen_t size;
+    if(!resolve(address, addr, size)){
+        return -1;
+    }
+    int fd = socket(addr.ss_family, SOCK_STREAM|SOCK_CLOEXEC, 0);
+    if(fd<0){
+        return -1;
+    }
+    if(::connect(fd, (sockaddr*)&addr, size)<0){
+        ::close(fd);
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return fd;
+}
+
+// Load generator: `clients` connections on one epoll loop, each playing
+// `rounds` rounds (bet 5, hit below 17). Returns the replies received, or -1
+// if a connection failed.
+long long Server::bench(const std::string &address, int clients, long long rounds){
+    struct Client{
+        int fd;
+        std::string in;
+        long long rounds;
+    };
+    std::vector<Client> all(clients);
+    int epoll = epoll_create1(EPOLL_CLOEXEC);
+    int left = clients;
+    for(int i=0;i<clients;i++){
+        all[i].fd = connect(address);
+        if(all[i].fd<0){
+            for(int j=0;j<i;j++){
+                ::close(all[j].fd);
+            }
+            ::close(epoll);
+            return -1;
+        }
+        all[i].rounds = 0;
+        setNonBlocking(all[i].fd);
+        epoll_event e;
+        e.events = EPOLLIN;
+        e.data.ptr = &all[i];
+        epoll_ctl(epoll, EPOLL_CTL_ADD, all[i].fd, &e);
+        std::string join;
+        Protocol::frame(join, Protocol::JOIN, "Bot", 3);
+        if(!sendAll(all[i].fd, join)){
+            ::close(all[i].fd);
+            left--;
+        }
+    }
+    long long replies = 0;
+    epoll_event events[64];
+    while(left>0){
+        int n = epoll_wait(epoll, events, 64, -1);
+        for(int i=0;i<n;i++){
+            Client &c = *(Client*)events[i].data.ptr;
+            char buf[4096];
+            ssize_t got = read(c.fd, buf, sizeof(buf));
+            if(got<=0){
+                if(got<0 && errno==EAGAIN){
+                    continue;
+                }
+                ::close(c.fd);
+                left--;
+                continue;
+            }
+            c.in.append(buf, got);
+            size_t at = 0;
+            int size;
+            std::string out;
+            bool done = false;
+            while((size = Protocol::frameSize(c.in, at))>0){
+                Protocol::View v;
+                const uint8_t *f = (const uint8_t*)c.in.data()+at;
+                at += size;
+                replies++;
+                if(size<2 || f[1]!=Protocol::STATE || !Protocol::readState(f+2, size-2, v)){
+                    continue;
+                }
+                switch(v.phase){
+                    case Table::BETTING: Protocol::frame(out, v.bet==0 ? Protocol::RAISE : Protocol::DEAL); break;
+                    case Table::PLAYING: Protocol::frame(out, v.player.getSum()<17 ? Protocol::HIT : Protocol::STAND); break;
+                    case Table::OVER: if(++c.rounds<rounds){
+                                          Protocol::frame(out, Protocol::NEXT);
+                                      }
+                                      else{
+                                          done = true;
+                                      }
+                                      break;
+                    default: done = true;
+                }
+            }
+            c.in.erase(0, at);
+            if(done || size<0){
+                ::close(c.fd);
+                left--;
+            }
+            else if(!out.empty() && !sendAll(c.fd, out)){
+                ::close(c.fd);
+                left--;
+            }
+        }
+    }
+    ::close(epoll);
+    return replies;
+}
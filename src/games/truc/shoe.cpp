@@ -0,0 +1,140 @@
+#include "headers/shoe.h"
+#include <cstring>
+
+//////////////* Shoe *////
+
+// Cut card placed after `penetration` of the shoe, leaving at least RESERVE cards
+Shoe::Shoe(int d, double penetration){
+    decks = d<1 ? 1 : d>MAX_DECKS ? MAX_DECKS : d;
+    size = decks*DECK_CARDS;
+    cut = (int)(size*penetration);
+    if(cut>size-RESERVE) cut = size-RESERVE;
+    if(cut<1) cut = 1;
+    next = size;
+    roundStart = 0;
+    running = 0;
+}
+
+void Shoe::seed(uint64_t s, uint64_t table){
+    rng.setSeed(s, table);
+}
+
+// Shuffles shoe `index` of the table in place
+void Shoe::shuffle(uint64_t index){
+    rng.setHand(index);
+    fill(cards, decks, rng);
+    next = 0;
+    roundStart = 0;
+    running = 0;
+}
+
+// Starts shoe `index` of the table, shuffled elsewhere (see ShoeBuffer)
+void Shoe::load(const Card shuffled[], uint64_t index){
+    rng.setHand(index);
+    memcpy(cards, shuffled, size);
+    next = 0;
+    roundStart = 0;
+    running = 0;
+}
+
+// Out of cards in the middle of a round: keeps the cards of the round in
+// front, shuffles the discards behind them and deals on from there, with
+// the count starting over. Without startRound() every card is a discard.
+void Shoe::reshuffleDiscards(){
+    int inPlay = roundStart>0 ? size-roundStart : 0;
+    Card discards[MAX_CARDS];
+    int n = size-inPlay;
+    memcpy(discards, cards, n);
+    memmove(cards, cards+n, inPlay);
+    rng.jump(DISCARD_BLOCK);
+    for(int i=n-1;i>0;i--){
+        int j = rng.below(i+1);
+        Card c = discards[i];
+        discards[i] = discards[j];
+        discards[j] = c;
+    }
+    memcpy(cards+inPlay, discards, n);
+    next = inPlay;
+    roundStart = 0;
+    running = 0;
+}
+
+// Writes `decks` decks in canonical order and shuffles them (Fisher-Yates)
+void Shoe::fill(Card out[], int decks, Rng &rng){
+    int n = 0;
+    for(int d=0;d<decks;d++){
+        for(int i=0;i<4;i++){
+            for(int j=1;j<=13;j++){
+                out[n++] = Card(j, CardTable::SUITS[i]);
+            }
+        }
+    }
+    for(int i=n-1;i>0;i--){
+        int j = rng.below(i+1);
+        Card c = out[i];
+        out[i] = out[j];
+        out[j] = c;
+    }
+}
+
+//////////////* Shoe Buffer *////
+
+ShoeBuffer::ShoeBuffer(int d, uint64_t s, uint64_t t, uint64_t f, uint64_t n):
+    produced(0), consumed(0), stopping(false){
+    decks = d<1 ? 1 : d>Shoe::MAX_DECKS ? Shoe::MAX_DECKS : d;
+    size = decks*Shoe::DECK_CARDS;
+    ring.resize((size_t)SLOTS*size);
+    seed = s;
+    table = t;
+    first = f;
+    count = n;
+    producer = std::thread(&ShoeBuffer::produce, this);
+}
+
+ShoeBuffer::~ShoeBuffer(){
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        changed.notify_all();
+    }
+    producer.join();
+}
+
+// Shuffler thread: fills free slots in shoe order
+void ShoeBuffer::produce(){
+    Rng rng(seed, table);
+    for(uint64_t i=0;i<count;i++){
+        if(produced-consumed>=SLOTS){
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this](){ return stopping || produced-consumed<SLOTS; });
+        }
+        if(stopping){
+            return;
+        }
+        rng.setHand(first+i);
+        Shoe::fill(&ring[(i%SLOTS)*size], decks, rng);
+        std::lock_guard<std::mutex> lock(mutex);
+        produced++;
+        changed.notify_all();
+    }
+}
+
+// Cards of the next shoe, in dealing order. Waits if it isn't shuffled yet;
+// returns NULL once all `count` shoes were released.
+const Card* ShoeBuffer::acquire(){
+    if(consumed>=count){
+        return NULL;
+    }
+    if(produced<=consumed){
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this](){ return produced>consumed; });
+    }
+    return &ring[(consumed%SLOTS)*size];
+}
+
+// Gives the slot of the acquired shoe back to the shuffler
+void ShoeBuffer::release(){
+    std::lock_guard<std::mutex> lock(mutex);
+    consumed++;
+    changed.notify_all();
+}
@@ -0,0 +1,39 @@
+#include "headers/truc.h"
+#include "headers/simulation.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Plays whole shoes to the cut card and prints the EV by true count
+int simulateShoes(long long shoes, int decks, double penetration, int threads, uint64_t seed, const StoppingRule &rule){
+    Simulation sim(0, threads, seed);
+    sim.setShoe(decks, penetration);
+    ProgressLine line("Hands", rule);
+    if(rule.isActive()){
+        sim.setStopping(&rule, [&line](const Welford &w){ line.show(w); });
+    }
+    auto start = std::chrono::steady_clock::now();
+    ShoeResult r = sim.runShoes(shoes);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    line.end(r.total.getUnits());
+    std::cout<<std::fixed<<std::setprecision(0);
+    std::cout<<"Shoes:   "<<r.shoes<<" of "<<decks<<" deck(s), cut at "<<100.0*penetration<<" % ("
+             <<r.total.hands<<" hands, "<<threads<<" threads, seed "<<seed<<")\n";
+    std::cout<<std::setprecision(4);
+    std::cout<<"EV:      "<<r.total.getEV()<<" +/- "<<1.96*r.total.getStdError()<<" per unit bet\n";
+    std::cout<<"True count   Hands       EV\n";
+    for(int i=0;i<2*ShoeResult::MAX_TRUE_COUNT+1;i++){
+        const SimulationResult &c = r.byCount[i];
+        if(c.hands==0){
+            continue;
+        }
+        std::cout<<std::setw(6)<<std::showpos<<i-ShoeResult::MAX_TRUE_COUNT<<std::noshowpos<<std::setprecision(2)<<std::setw(12)
+                 <<100.0*c.hands/r.total.hands<<" %"<<std::setprecision(4)<<std::setw(10)<<c.getEV()<<" +/- "<<1.96*c.getStdError()<<"\n";
+    }
+    std::cout<<std::setprecision(2);
+    std::cout<<"Time:    "<<secs<<" s ("<<(secs>0 ? r.total.hands/secs/1e6*60 : 0.0)<<" M hands/min)\n";
+    if(rule.isActive()){
+        printVerdict(sim.getVerdict(), rule, r.total.getUnits(), "EV");
+    }
+    return 0;
+}
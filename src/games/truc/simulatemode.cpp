@@ -0,0 +1,31 @@
+#include "headers/truc.h"
+#include "headers/simulation.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Runs the headless Monte Carlo mode and prints the aggregate report
+int simulate(long long hands, int threads, uint64_t seed, const StoppingRule &rule){
+    Simulation sim(hands, threads, seed);
+    ProgressLine line("Hands", rule);
+    if(rule.isActive()){
+        sim.setStopping(&rule, [&line](const Welford &w){ line.show(w); });
+    }
+    auto start = std::chrono::steady_clock::now();
+    SimulationResult r = sim.run();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    line.end(r.getUnits());
+    double n = r.hands>0 ? (double)r.hands : 1.0;
+    std::cout<<std::fixed<<std::setprecision(4);
+    std::cout<<"Hands:   "<<r.hands<<" ("<<threads<<" threads, seed "<<seed<<")\n";
+    std::cout<<"Wins:    "<<100.0*r.wins/n<<" %\n";
+    std::cout<<"Loses:   "<<100.0*r.loses/n<<" %\n";
+    std::cout<<"Pushes:  "<<100.0*r.pushes/n<<" %\n";
+    std::cout<<"EV:      "<<r.getEV()<<" +/- "<<1.96*r.getStdError()<<" per unit bet\n";
+    std::cout<<std::setprecision(2);
+    std::cout<<"Time:    "<<secs<<" s ("<<(secs>0 ? r.hands/secs/1e6*60 : 0.0)<<" M hands/min)\n";
+    if(rule.isActive()){
+        printVerdict(sim.getVerdict(), rule, r.getUnits(), "EV");
+    }
+    return 0;
+}
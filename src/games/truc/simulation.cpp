@@ -0,0 +1,372 @@
+#include "headers/simulation.h"
+#include "headers/gameengine.h"
+#include "headers/rules.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//////////////* Simulation Result *////
+
+SimulationResult::SimulationResult(){
+    hands = 0;
+    wins = 0;
+    loses = 0;
+    pushes = 0;
+}
+
+// Counts one finished hand
+void SimulationResult::add(char result){
+    hands++;
+    switch(result){
+        case 'p': wins++; break;
+        case 'd': loses++; break;
+        case 'n': pushes++; break;
+    }
+}
+
+// Adds the counts of another (worker) result
+void SimulationResult::merge(const SimulationResult &r){
+    hands += r.hands;
+    wins += r.wins;
+    loses += r.loses;
+    pushes += r.pushes;
+}
+
+// Expected value per unit bet (wins pay 1:1)
+double SimulationResult::getEV() const{
+    if(hands==0) return 0.0;
+    return (double)(wins-loses)/hands;
+}
+
+// Standard error of getEV()
+double SimulationResult::getStdError() const{
+    if(hands<2) return 0.0;
+    double ev = getEV();
+    double second = (double)(wins+loses)/hands;
+    return std::sqrt((second-ev*ev)/(hands-1));
+}
+
+// Per hand results in units (+1, 0, -1)
+Welford SimulationResult::getUnits() const{
+    return Welford(hands, wins-loses, wins+loses);
+}
+
+//////////////* Shoe Result *////
+
+ShoeResult::ShoeResult(){
+    shoes = 0;
+}
+
+void ShoeResult::merge(const ShoeResult &r){
+    shoes += r.shoes;
+    total.merge(r.total);
+    for(int i=0;i<2*MAX_TRUE_COUNT+1;i++){
+        byCount[i].merge(r.byCount[i]);
+    }
+}
+
+// Index in byCount of a true count, rounded to the nearest integer
+int ShoeResult::bucket(double trueCount){
+    int tc = (int)(trueCount<0 ? trueCount-0.5 : trueCount+0.5);
+    if(tc<-MAX_TRUE_COUNT) tc = -MAX_TRUE_COUNT;
+    if(tc>MAX_TRUE_COUNT) tc = MAX_TRUE_COUNT;
+    return tc+MAX_TRUE_COUNT;
+}
+
+//////////////* Paired Result *////
+
+PairedResult::PairedResult(){
+    samples = 0;
+    handsPerSample = 1;
+    for(int i=0;i<3;i++){
+        sum[i] = 0;
+        sumSq[i] = 0;
+    }
+}
+
+// Counts one sample with outcomes a and b
+void PairedResult::add(int a, int b){
+    int x[3] = {a, b, a-b};
+    samples++;
+    for(int i=0;i<3;i++){
+        sum[i] += x[i];
+        sumSq[i] += (long long)x[i]*x[i];
+    }
+}
+
+void PairedResult::merge(const PairedResult &r){
+    samples += r.samples;
+    hands[A].merge(r.hands[A]);
+    hands[B].merge(r.hands[B]);
+    for(int i=0;i<3;i++){
+        sum[i] += r.sum[i];
+        sumSq[i] += r.sumSq[i];
+    }
+}
+
+// Per hand and unit bet
+double PairedResult::getMean(Series s) const{
+    if(samples==0) return 0.0;
+    return (double)sum[s]/samples/handsPerSample;
+}
+
+// Standard error of getMean(s), from the spread of the samples
+double PairedResult::getStdError(Series s) const{
+    if(samples<2) return 0.0;
+    double mean = (double)sum[s]/samples;
+    double variance = ((double)sumSq[s]/samples-mean*mean)*samples/(samples-1);
+    return std::sqrt(variance/samples)/handsPerSample;
+}
+
+// How many times the hands two independent runs would need for the
+// standard error of A-B reached here
+double PairedResult::getGain() const{
+    double paired = getStdError(DIFF);
+    if(paired==0.0) return 0.0;
+    double independent = hands[A].getStdError()*hands[A].getStdError()+hands[B].getStdError()*hands[B].getStdError();
+    return independent/(paired*paired);
+}
+
+// Per hand results of a series in units
+Welford PairedResult::getUnits(Series s) const{
+    double h = handsPerSample;
+    return Welford(samples, sum[s]/h, sumSq[s]/(h*h));
+}
+
+//////////////* Constructor & Setters *////
+
+Simulation::Simulation(long long n, int t, uint64_t s){
+    hands = n;
+    threads = t>0 ? t : 1;
+    seed = s;
+    standOn = Rules::DEALER_STANDS;
+    decks = 6;
+    penetration = 0.75;
+    stopping = NULL;
+    verdict = StoppingRule::CONTINUE;
+}
+
+void Simulation::setStandOn(int s){
+    standOn = s;
+}
+
+void Simulation::setShoe(int d, double p){
+    decks = d;
+    penetration = p;
+}
+
+void Simulation::setStopping(const StoppingRule *rule, const std::function<void(const Welford &w)> &report){
+    stopping = rule;
+    progress = report;
+}
+
+StoppingRule::Verdict Simulation::getVerdict() const{
+    return verdict;
+}
+
+//////////////* Hand Loop *////
+
+// Plays hands [first, first+count) through GameEngine<ClassicBlackjack>.
+// Hand i always uses stream (seed, 0, i), so the totals don't depend on the
+// number of threads.
+void Simulation::runWorker(long long first, long long count, SimulationResult *out){
+    GameEngine<ClassicBlackjack> engine(seed);
+    HitBelow policy = {standOn};
+    SimulationResult local;
+    engine.setRound(first);
+    for(long long i=0;i<count;i++){
+        local.add(engine.playRound(policy));
+    }
+    *out = local;
+}
+
+// Plays shoes [first, first+count) of table 1 to the cut card. A background
+// ShoeBuffer shuffles the next shoes while this one is played.
+void Simulation::runShoeWorker(long long first, long long count, ShoeResult *out){
+    ShoeBuffer buffer(decks, seed, 1, first, count);
+    Shoe shoe(decks, penetration);
+    ClassicBlackjack::State state;
+    HitBelow policy = {standOn};
+    ShoeResult local;
+    shoe.seed(seed, 1);
+    for(const Card *cards=buffer.acquire();cards!=NULL;cards=buffer.acquire()){
+        shoe.load(cards, first+local.shoes);
+        buffer.release();
+        while(!shoe.needsShuffle()){
+            int b = ShoeResult::bucket(shoe.getTrueCount());
+            shoe.startRound();
+            ClassicBlackjack::deal(state, shoe);
+            char result = ClassicBlackjack::play(state, shoe, policy);
+            local.total.add(result);
+            local.byCount[b].add(result);
+        }
+        local.shoes++;
+    }
+    *out = local;
+}
+
+// Complement of every card of a deck, keeping the suit: ace and king, 2 and
+// queen ... 6 and 8, 7 with itself. A shuffle and its mirror are equally
+// likely, and low cards of one are high cards of the other.
+struct MirroredDeck{
+    Deck &deck;
+    Card deal(){
+        Card c = deck.deal();
+        return Card::fromCode((c.getCode()&~15) | (14-c.getNumber()));
+    }
+};
+
+// Plays shuffles [first, first+count) with both players. Shuffle i is hand
+// i of run() (stream (seed, 0, i)), replayed for each player; antithetic
+// also plays its mirror.
+void Simulation::runPairedWorker(long long first, long long count, const ChartOrHitBelow *players, bool antithetic,
+                                 PairedResult *out){
+    Deck deck(ClassicBlackjack::DECK);
+    MirroredDeck mirrored = {deck};
+    ClassicBlackjack::State state;
+    PairedResult local;
+    deck.seed(seed, 0);
+    local.handsPerSample = antithetic ? 2 : 1;
+    for(long long i=first;i<first+count;i++){
+        int units[2] = {0, 0};
+        for(int p=0;p<2;p++){
+            deck.initializeDeck();
+            deck.setHand(i);
+            ClassicBlackjack::deal(state, deck);
+            char result = ClassicBlackjack::play(state, deck, players[p]);
+            local.hands[p].add(result);
+            units[p] += result=='p' ? 1 : result=='d' ? -1 : 0;
+            if(antithetic){
+                deck.initializeDeck();
+                deck.setHand(i);
+                ClassicBlackjack::deal(state, mirrored);
+                result = ClassicBlackjack::play(state, mirrored, players[p]);
+                local.hands[p].add(result);
+                units[p] += result=='p' ? 1 : result=='d' ? -1 : 0;
+            }
+        }
+        local.add(units[0], units[1]);
+    }
+    *out = local;
+}
+
+//////////////* Runner *////
+
+SimulationResult Simulation::run(){
+    if(stopping!=NULL){
+        // Chunk c is hands [c*CHUNK, (c+1)*CHUNK), the EV is tested after each
+        const long long CHUNK = 1<<16;
+        SimulationResult total;
+        Welford units;
+        verdict = StoppingRule::CONTINUE;
+        runChunks<SimulationResult>((hands+CHUNK-1)/CHUNK, threads,
+            [this, CHUNK](long long c, SimulationResult &r){
+                runWorker(c*CHUNK, std::min(CHUNK, hands-c*CHUNK), &r);
+            },
+            [this, &total, &units](const SimulationResult &r){
+                total.merge(r);
+                units.merge(r.getUnits());
+                if(progress) progress(units);
+                verdict = stopping->check(units);
+                return verdict!=StoppingRule::CONTINUE;
+            });
+        return total;
+    }
+    std::vector<SimulationResult> partial(threads);
+    std::vector<std::thread> workers;
+    long long first = 0;
+    for(int i=0;i<threads;i++){
+        long long count = hands/threads + (i < hands%threads ? 1 : 0);
+        workers.push_back(std::thread(&Simulation::runWorker, this, first, count, &partial[i]));
+        first += count;
+    }
+    SimulationResult total;
+    for(int i=0;i<threads;i++){
+        workers[i].join();
+        total.merge(partial[i]);
+    }
+    return total;
+}
+
+// Plays `shoes` whole shoes. Shoe i is always shuffled from stream
+// (seed, 1, i), so the totals don't depend on the number of threads.
+ShoeResult Simulation::runShoes(long long shoes){
+    if(stopping!=NULL){
+        // Chunk c is shoes [c*CHUNK, (c+1)*CHUNK), the EV per hand is tested
+        // after each
+        const long long CHUNK = 1<<10;
+        ShoeResult total;
+        Welford units;
+        verdict = StoppingRule::CONTINUE;
+        runChunks<ShoeResult>((shoes+CHUNK-1)/CHUNK, threads,
+            [this, CHUNK, shoes](long long c, ShoeResult &r){
+                runShoeWorker(c*CHUNK, std::min(CHUNK, shoes-c*CHUNK), &r);
+            },
+            [this, &total, &units](const ShoeResult &r){
+                total.merge(r);
+                units.merge(r.total.getUnits());
+                if(progress) progress(units);
+                verdict = stopping->check(units);
+                return verdict!=StoppingRule::CONTINUE;
+            });
+        return total;
+    }
+    std::vector<ShoeResult> partial(threads);
+    std::vector<std::thread> workers;
+    long long first = 0;
+    for(int i=0;i<threads;i++){
+        long long count = shoes/threads + (i < shoes%threads ? 1 : 0);
+        workers.push_back(std::thread(&Simulation::runShoeWorker, this, first, count, &partial[i]));
+        first += count;
+    }
+    ShoeResult total;
+    for(int i=0;i<threads;i++){
+        workers[i].join();
+        total.merge(partial[i]);
+    }
+    return total;
+}
+
+// Plays `hands` hands with each player on the same shuffles, half of them
+// mirrored when antithetic. Mirrored hands come in pairs, so an odd count
+// is rounded up to the next pair.
+PairedResult Simulation::compare(const ChartOrHitBelow &a, const ChartOrHitBelow &b, bool antithetic){
+    ChartOrHitBelow players[2] = {a, b};
+    long long shuffles = antithetic ? (hands+1)/2 : hands;
+    if(stopping!=NULL){
+        // Chunk c is shuffles [c*CHUNK, (c+1)*CHUNK), A-B is tested after each
+        const long long CHUNK = 1<<15;
+        PairedResult total;
+        Welford diff;
+        total.handsPerSample = antithetic ? 2 : 1;
+        verdict = StoppingRule::CONTINUE;
+        runChunks<PairedResult>((shuffles+CHUNK-1)/CHUNK, threads,
+            [this, CHUNK, shuffles, &players, antithetic](long long c, PairedResult &r){
+                runPairedWorker(c*CHUNK, std::min(CHUNK, shuffles-c*CHUNK), players, antithetic, &r);
+            },
+            [this, &total, &diff](const PairedResult &r){
+                total.merge(r);
+                diff.merge(r.getUnits(PairedResult::DIFF));
+                if(progress) progress(diff);
+                verdict = stopping->check(diff);
+                return verdict!=StoppingRule::CONTINUE;
+            });
+        return total;
+    }
+    std::vector<PairedResult> partial(threads);
+    std::vector<std::thread> workers;
+    long long first = 0;
+    for(int i=0;i<threads;i++){
+        long long count = shuffles/threads + (i < shuffles%threads ? 1 : 0);
+        workers.push_back(std::thread(&Simulation::runPairedWorker, this, first, count, players, antithetic, &partial[i]));
+        first += count;
+    }
+    PairedResult total;
+    total.handsPerSample = antithetic ? 2 : 1;
+    for(int i=0;i<threads;i++){
+        workers[i].join();
+        total.merge(partial[i]);
+    }
+    return total;
+}
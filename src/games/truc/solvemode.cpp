@@ -0,0 +1,46 @@
+#include "headers/truc.h"
+#include "headers/solver.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Rules of a solved chart, with a flat one-unit bet
+std::vector<StrategyTable::Entry> chartEntries(const Solver &solver){
+    std::vector<StrategyTable::Entry> entries;
+    for(int ace=0;ace<2;ace++){
+        for(int hard=(ace ? 2 : 4);hard<=(ace ? 10 : 20);hard++){
+            for(int up=1;up<=10;up++){
+                entries.push_back({StrategyTable::playKey(Solver::getTotal(hard, ace), ace, up), (uint8_t)solver.getAction(hard, ace, up)});
+            }
+        }
+    }
+    for(int c=0;c<=Deck::MAX_CARDS;c++){
+        entries.push_back({StrategyTable::betKey(c), 1});
+    }
+    return entries;
+}
+
+// Solves a fresh shoe of `decks` decks (an infinite shoe for 0) and prints
+// the basic strategy chart, also compiled to `path` when it is not empty
+int solve(int decks, int threads, const std::string &path){
+    Solver solver = decks>0 ? Solver(Composition::decks(decks)) : Solver();
+    auto start = std::chrono::steady_clock::now();
+    solver.solve(threads);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    const int ups[10] = {2, 3, 4, 5, 6, 7, 8, 9, 10, 1};
+    std::cout<<"Basic strategy, "<<(decks>0 ? std::to_string(decks)+" deck(s)" : "infinite deck")<<", solved in "<<std::fixed<<std::setprecision(3)<<secs<<" s\n";
+    std::cout<<"Dealer:   2  3  4  5  6  7  8  9  X  A\n";
+    for(int ace=0;ace<2;ace++){
+        for(int hard=(ace ? 2 : 4);hard<=(ace ? 10 : 20);hard++){
+            std::cout<<(ace ? "Soft " : "Hard ")<<std::setw(2)<<Solver::getTotal(hard, ace)<<" ";
+            for(int i=0;i<10;i++){
+                std::cout<<"  "<<solver.getAction(hard, ace, ups[i]);
+            }
+            std::cout<<"\n";
+        }
+    }
+    if(path.empty()){
+        return 0;
+    }
+    return writeStrategy(chartEntries(solver), path);
+}
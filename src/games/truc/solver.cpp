@@ -0,0 +1,227 @@
+#include "headers/solver.h"
+#include "headers/rules.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//////////////* Constructor *////
+
+// Infinite shoe
+Solver::Solver(): Solver(Composition::decks(1)){
+    infinite = true;
+}
+
+Solver::Solver(const Composition &c){
+    shoe = c;
+    infinite = false;
+    for(int u=0;u<11;u++){
+        for(int h=0;h<=MAX_HARD;h++){
+            for(int a=0;a<2;a++){
+                stand[u][h][a] = 0.0;
+                hit[u][h][a] = 0.0;
+            }
+        }
+    }
+}
+
+int Solver::getTotal(int hard, bool ace){
+    return (ace && hard<=11) ? hard+10 : hard;
+}
+
+//////////////* Expected Values *////
+
+// Relative odds of drawing value index v (tens are index 9). An infinite
+// shoe is never drawn from, so its composition and memo keys stay fixed.
+double Solver::weight(const Worker &w, const Composition &c, int v){
+    if(w.infinite){
+        return v==9 ? 4.0/13 : 1.0/13;
+    }
+    return c.total>0 ? (double)c.count[v]/c.total : 0.0;
+}
+
+// Chance that the hole card, drawn from `c`, doesn't give the dealer 21
+double Solver::noBlackjack(const Worker &w, const Composition &c){
+    switch(w.up){
+        case 1: return 1.0-weight(w, c, 9);
+        case 10: return 1.0-weight(w, c, 0);
+    }
+    return 1.0;
+}
+
+// Player stands on `total` (below 21) and the hole card comes from `c`:
+// EV times the chance that the dealer has no 21 (the other hole cards
+// ended the round before the player drew)
+double Solver::standEV(Worker &w, int total, const Composition &c){
+    uint64_t key = w.infinite ? total : c.getKey();
+    auto it = w.standMemo.find(key);
+    if(it!=w.standMemo.end()){
+        return it->second;
+    }
+    double ev = 0.0;
+    Composition rest = c;
+    for(int v=0;v<Composition::VALUES;v++){
+        double p = weight(w, c, v);
+        if(p==0.0){
+            continue;
+        }
+        int hard = w.up+v+1;
+        bool ace = w.up==1 || v==0;
+        int dealer = getTotal(hard, ace);
+        if(dealer==Rules::BLACKJACK){
+            continue;
+        }
+        if(!Rules::dealerPlays(dealer, total)){
+            switch(Rules::compareSum(dealer, total)){
+                case 'p': ev += p; break;
+                case 'd': ev -= p; break;
+            }
+            continue;
+        }
+        DealerOutcome o;
+        if(w.infinite){
+            o = DealerOdds::getInfinite(hard, ace);
+        }
+        else{
+            rest.remove(v);
+            o = w.odds.getFromHand(hard, ace, rest);
+            rest.add(v);
+        }
+        double sub = o.p[DealerOutcome::BUST];
+        for(int d=Rules::DEALER_STANDS;d<=Rules::BLACKJACK;d++){
+            char result = Rules::checkEnd(d, total);
+            if(result=='f'){
+                result = Rules::compareSum(d, total);
+            }
+            switch(result){
+                case 'p': sub += o.get(d); break;
+                case 'd': sub -= o.get(d); break;
+            }
+        }
+        ev += p*sub;
+    }
+    w.standMemo.emplace(key, ev);
+    return ev;
+}
+
+// Player takes exactly one card, then plays on optimally. Like standEV(),
+// times the chance that the dealer has no 21.
+double Solver::hitEV(Worker &w, int hard, bool ace, Composition &c){
+    double ev = 0.0;
+    for(int v=0;v<Composition::VALUES;v++){
+        double p = weight(w, c, v);
+        if(p==0.0){
+            continue;
+        }
+        if(w.infinite){
+            ev += p*bestEV(w, hard+v+1, ace || v==0, c);
+            continue;
+        }
+        c.remove(v);
+        ev += p*bestEV(w, hard+v+1, ace || v==0, c);
+        c.add(v);
+    }
+    return ev;
+}
+
+// Best of hitting and standing; a 21 wins at once and a bust loses. Every
+// choice here shares the chance of no dealer 21, so comparing the products
+// picks the same play as comparing the EVs.
+double Solver::bestEV(Worker &w, int hard, bool ace, Composition &c){
+    int total = getTotal(hard, ace);
+    if(total>Rules::BLACKJACK) return -noBlackjack(w, c);
+    if(total==Rules::BLACKJACK) return noBlackjack(w, c);
+    uint64_t key = w.infinite ? hard*2+ace : c.getKey();
+    auto it = w.bestMemo.find(key);
+    if(it!=w.bestMemo.end()){
+        return it->second;
+    }
+    double s = standEV(w, total, c);
+    double h = c.total>0 ? hitEV(w, hard, ace, c) : s;
+    double ev = s>h ? s : h;
+    w.bestMemo.emplace(key, ev);
+    return ev;
+}
+
+//////////////* Solving *////
+
+// Fills the chart column of one up-card (1 = ace ... 10). A cell is the
+// average over the two-card hands reaching it, weighted by their odds and
+// the chance of no dealer 21 with them out of the shoe.
+void Solver::solveUp(int up){
+    Worker w;
+    w.up = up;
+    w.infinite = infinite;
+    w.afterUp = shoe;
+    int idx = up==10 ? 9 : up-1;
+    if(w.afterUp.count[idx]==0){
+        return;
+    }
+    if(!infinite){
+        w.afterUp.remove(idx);
+    }
+    double odds[MAX_HARD+1][2] = {};
+    for(int v1=0;v1<Composition::VALUES;v1++){
+        for(int v2=v1;v2<Composition::VALUES;v2++){
+            int hard = v1+v2+2;
+            bool ace = v1==0;
+            if(getTotal(hard, ace)>=Rules::BLACKJACK){
+                continue;
+            }
+            Composition c = w.afterUp;
+            double p = weight(w, c, v1);
+            if(!infinite && p>0){
+                c.remove(v1);
+            }
+            p *= (v1==v2 ? 1 : 2)*weight(w, c, v2);
+            if(p==0.0){
+                continue;
+            }
+            if(!infinite){
+                c.remove(v2);
+            }
+            double s = standEV(w, getTotal(hard, ace), c);
+            stand[up][hard][ace] += p*s;
+            hit[up][hard][ace] += p*(c.total>0 ? hitEV(w, hard, ace, c) : s);
+            odds[hard][ace] += p*noBlackjack(w, c);
+        }
+    }
+    for(int hard=2;hard<=MAX_HARD;hard++){
+        for(int a=0;a<2;a++){
+            if(odds[hard][a]>0){
+                stand[up][hard][a] /= odds[hard][a];
+                hit[up][hard][a] /= odds[hard][a];
+            }
+        }
+    }
+}
+
+// Solves every up-card, spreading them over `threads` workers
+void Solver::solve(int threads){
+    std::atomic<int> next(1);
+    std::vector<std::thread> workers;
+    for(int i=0;i<(threads>0 ? threads : 1);i++){
+        workers.push_back(std::thread([this, &next](){
+            for(int up=next++;up<=10;up=next++){
+                solveUp(up);
+            }
+        }));
+    }
+    for(std::thread &w: workers){
+        w.join();
+    }
+}
+
+//////////////* Getter Functions *////
+
+double Solver::getStand(int hard, bool ace, int up) const{
+    return stand[up][hard][ace];
+}
+
+double Solver::getHit(int hard, bool ace, int up) const{
+    return hit[up][hard][ace];
+}
+
+// 'H' (hit) or 'S' (stand)
+char Solver::getAction(int hard, bool ace, int up) const{
+    return hit[up][hard][ace]>stand[up][hard][ace] ? 'H' : 'S';
+}
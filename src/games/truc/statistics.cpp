@@ -84,15 +84,15 @@ bool Statistics::check(Player pl){
 
 //////////////* Printing *////
 
-void Statistics::print(){
+void Statistics::print(std::ostream &out){
     int maxlength = std::max(std::max(p[0].getName().length(), p[1].getName().length()),p[2].getName().length());
     for(int i=0;i<3;i++){
         switch(i){
-            case 0: std::cout<<"MAX CASH  ||||||||| "; break;
-            case 1: std::cout<<"MAX WINS  ||||||||| "; break;
-            case 2: std::cout<<"MAX LOSES ||||||||| ";
+            case 0: out<<"MAX CASH  ||||||||| "; break;
+            case 1: out<<"MAX WINS  ||||||||| "; break;
+            case 2: out<<"MAX LOSES ||||||||| ";
         }
-        std::cout<<std::setw(maxlength+1)<<p[i].getName()<<"\t | \t"<<lightGreen<<"Cash: "<<std::setw(7)<<p[i].getCash()<<"\t | \t"<<yellow<<"Wins: "<<std::setw(5)<<p[i].getWins()<<"\t | \t"<<lightRed<<"Loses: "<<std::setw(5)<<p[i].getLoses()<<def<<"\n";
+        out<<std::setw(maxlength+1)<<p[i].getName()<<"\t | \t"<<lightGreen<<"Cash: "<<std::setw(7)<<p[i].getCash()<<"\t | \t"<<yellow<<"Wins: "<<std::setw(5)<<p[i].getWins()<<"\t | \t"<<lightRed<<"Loses: "<<std::setw(5)<<p[i].getLoses()<<def<<"\n";
     }
 }
 
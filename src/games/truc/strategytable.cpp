@@ -0,0 +1,164 @@
+#include "headers/strategytable.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+static const char STRATEGY_MAGIC[8] = "TRUCST1";
+static const uint32_t MAX_DISPLACEMENT = 1<<24;
+
+struct StrategyHeader{
+    char magic[8];
+    uint32_t keys;
+    uint32_t buckets;
+};
+
+//////////////* Descriptions *////
+
+// Reads "a" or "a-b" into [lo, hi]
+static bool parseRange(const std::string &word, int &lo, int &hi){
+    size_t dash = word.find('-');
+    char *end;
+    lo = strtol(word.c_str(), &end, 10);
+    if(end==word.c_str()){
+        return false;
+    }
+    hi = dash==std::string::npos ? lo : strtol(word.c_str()+dash+1, &end, 10);
+    return *end=='\0' && lo<=hi;
+}
+
+// Appends the entries of one description line, returns false if it is invalid
+bool StrategyTable::parse(const std::string &line, std::vector<Entry> &out){
+    std::istringstream in(line.substr(0, line.find('#')));
+    std::string kind;
+    if(!(in>>kind)){
+        return true;
+    }
+    if(kind=="play"){
+        std::string soft, totals, ups, action;
+        int t0, t1, u0, u1;
+        if(!(in>>soft>>totals>>ups>>action) || (soft!="hard" && soft!="soft") || (action!="H" && action!="S")
+           || !parseRange(totals, t0, t1) || !parseRange(ups, u0, u1) || t0<2 || t1>31 || u0<1 || u1>10){
+            return false;
+        }
+        for(int t=t0;t<=t1;t++){
+            for(int u=u0;u<=u1;u++){
+                out.push_back({playKey(t, soft=="soft", u), (uint8_t)action[0]});
+            }
+        }
+        return true;
+    }
+    if(kind=="bet"){
+        std::string cards;
+        int c0, c1, units;
+        if(!(in>>cards>>units) || !parseRange(cards, c0, c1) || c0<0 || c1>255 || units<0 || units>255){
+            return false;
+        }
+        for(int c=c0;c<=c1;c++){
+            out.push_back({betKey(c), (uint8_t)units});
+        }
+        return true;
+    }
+    return false;
+}
+
+//////////////* Compiler *////
+
+// Builds the perfect hash for `entries`. Buckets average 4 keys and are
+// placed largest first, each trying displacements until all of its keys land
+// on free slots. Fails on duplicate keys.
+bool StrategyTable::compile(const std::vector<Entry> &entries){
+    size_t n = entries.size();
+    std::vector<uint32_t> keys(n);
+    for(size_t i=0;i<n;i++){
+        keys[i] = entries[i].key;
+    }
+    std::sort(keys.begin(), keys.end());
+    if(std::adjacent_find(keys.begin(), keys.end())!=keys.end()){
+        return false;
+    }
+    size_t m = n/4+1;
+    std::vector<std::vector<int> > buckets(m);
+    for(size_t i=0;i<n;i++){
+        buckets[reduce(hash(entries[i].key, 0), m)].push_back(i);
+    }
+    std::vector<int> order(m);
+    for(size_t b=0;b<m;b++){
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buckets](int a, int b){ return buckets[a].size()>buckets[b].size(); });
+    std::vector<uint32_t> disp(m, 0);
+    std::vector<Slot> table(n);
+    std::vector<bool> used(n, false);
+    std::vector<size_t> placed;
+    for(size_t o=0;o<m;o++){
+        const std::vector<int> &bucket = buckets[order[o]];
+        uint32_t d = 1;
+        for(;d<MAX_DISPLACEMENT;d++){
+            placed.clear();
+            bool ok = true;
+            for(size_t k=0;k<bucket.size() && ok;k++){
+                size_t slot = reduce(hash(entries[bucket[k]].key, d), n);
+                ok = !used[slot] && std::find(placed.begin(), placed.end(), slot)==placed.end();
+                placed.push_back(slot);
+            }
+            if(ok){
+                break;
+            }
+        }
+        if(d==MAX_DISPLACEMENT){
+            return false;
+        }
+        disp[order[o]] = d;
+        for(size_t k=0;k<bucket.size();k++){
+            used[placed[k]] = true;
+            table[placed[k]] = {entries[bucket[k]].key, entries[bucket[k]].action};
+        }
+    }
+    displacement.swap(disp);
+    slots.swap(table);
+    return true;
+}
+
+//////////////* Data File Handling *////
+
+bool StrategyTable::save(const std::string &path) const{
+    StrategyHeader h;
+    memcpy(h.magic, STRATEGY_MAGIC, sizeof(STRATEGY_MAGIC));
+    h.keys = slots.size();
+    h.buckets = displacement.size();
+    std::fstream f1;
+    f1.open(path, std::ios::out | std::ios::binary);
+    if(f1.fail()){
+        return false;
+    }
+    f1.write((char*)&h, sizeof(h));
+    f1.write((char*)displacement.data(), displacement.size()*sizeof(uint32_t));
+    f1.write((char*)slots.data(), slots.size()*sizeof(Slot));
+    f1.close();
+    return !f1.fail();
+}
+
+bool StrategyTable::load(const std::string &path){
+    std::fstream f1;
+    f1.open(path, std::ios::in | std::ios::binary);
+    if(f1.fail()){
+        return false;
+    }
+    StrategyHeader h;
+    f1.read((char*)&h, sizeof(h));
+    if(f1.fail() || memcmp(h.magic, STRATEGY_MAGIC, sizeof(STRATEGY_MAGIC))!=0 || h.buckets!=h.keys/4+1){
+        return false;
+    }
+    std::vector<uint32_t> disp(h.buckets);
+    std::vector<Slot> table(h.keys);
+    f1.read((char*)disp.data(), disp.size()*sizeof(uint32_t));
+    f1.read((char*)table.data(), table.size()*sizeof(Slot));
+    if(f1.fail()){
+        return false;
+    }
+    displacement.swap(disp);
+    slots.swap(table);
+    return true;
+}
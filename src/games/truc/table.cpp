@@ -0,0 +1,161 @@
+#include "headers/table.h"
+#include "headers/seat.h"
+
+//////////////* Constructor *////
+
+Table::Table(uint64_t seed, uint64_t id): deck(Variant::DECK){
+    name = "Unknown";
+    cash = 1000;
+    bet = 0;
+    wins = 0;
+    loses = 0;
+    round = 0;
+    deck.seed(seed, id);
+    deck.initializeDeck();
+    phase = OVER;
+    next();
+}
+
+//////////////* Round Flow *////
+
+// Starts the next round with an empty bet
+bool Table::next(){
+    if(phase!=OVER){
+        return false;
+    }
+    if(deck.getSize()<36){
+        deck.initializeDeck();
+    }
+    deck.setHand(round++);
+    hands.player.clearCards();
+    hands.dealer.clearCards();
+    bet = 0;
+    result = 'f';
+    phase = cash>0 ? BETTING : BANKRUPT;
+    return true;
+}
+
+bool Table::raise(){
+    if(phase!=BETTING || cash<STEP){
+        return false;
+    }
+    cash -= STEP;
+    bet += STEP;
+    return true;
+}
+
+bool Table::lower(){
+    if(phase!=BETTING || bet<STEP){
+        return false;
+    }
+    cash += STEP;
+    bet -= STEP;
+    return true;
+}
+
+// Deals two cards each; a 21 ends the round straight away
+bool Table::deal(){
+    if(phase!=BETTING){
+        return false;
+    }
+    Variant::deal(hands, deck);
+    phase = PLAYING;
+    char r = Variant::checkEnd(hands);
+    if(r!='f'){
+        finish(r);
+    }
+    return true;
+}
+
+bool Table::hit(){
+    if(phase!=PLAYING){
+        return false;
+    }
+    char r = Variant::hit(hands, deck);
+    if(r!='f'){
+        finish(r);
+    }
+    return true;
+}
+
+// The dealer plays out its hand
+bool Table::stand(){
+    if(phase!=PLAYING){
+        return false;
+    }
+    finish(Variant::stand(hands, deck));
+    return true;
+}
+
+//////////////* Checkers *////
+
+void Table::finish(char r){
+    switch(r){
+        case 'p': wins++; break;
+        case 'd': loses++; break;
+    }
+    cash += Variant::ScoringPolicy::payout(r, bet);
+    result = r;
+    phase = OVER;
+}
+
+//////////////* Coroutine Flow *////
+
+// Next action of the seat; `fallback` is played for it after idleMs (0 = never)
+Task<int> Table::decide(Seat &seat, Scheduler &s, int idleMs, Action fallback){
+    seat.ask(*this);
+    int a = co_await seat.action.within(s, idleMs, fallback);
+    co_return a;
+}
+
+// Bet loop, false when the seat leaves (an idle seat is let go)
+Task<bool> Table::placeBet(Seat &seat, Scheduler &s, int idleMs){
+    while(phase==BETTING){
+        int a = co_await decide(seat, s, idleMs, LEAVE);
+        switch(a){
+            case RAISE: raise(); break;
+            case LOWER: lower(); break;
+            case DEAL: deal(); break;
+            case LEAVE: co_return false;
+        }
+    }
+    co_return true;
+}
+
+// Hits until the round ends or the seat stands (an idle seat stands)
+Task<bool> Table::playHand(Seat &seat, Scheduler &s, int idleMs){
+    while(phase==PLAYING){
+        int a = co_await decide(seat, s, idleMs, STAND);
+        switch(a){
+            case HIT: hit(); break;
+            case STAND: stand(); break;
+            case LEAVE: co_return false;
+        }
+    }
+    co_return true;
+}
+
+// Rounds until the seat leaves or goes bankrupt. Every round ends with a
+// yield so a fast seat (a bot) doesn't hold up the other tables.
+Task<void> Table::play(Seat &seat, Scheduler &s, int idleMs){
+    while(phase!=BANKRUPT){
+        bool betting = co_await placeBet(seat, s, idleMs);
+        if(!betting){
+            co_return;
+        }
+        bool playing = co_await playHand(seat, s, idleMs);
+        if(!playing){
+            co_return;
+        }
+        while(phase==OVER){
+            int a = co_await decide(seat, s, idleMs, LEAVE);
+            if(a==LEAVE){
+                co_return;
+            }
+            if(a==NEXT){
+                next();
+            }
+        }
+        co_await s.yield();
+    }
+}
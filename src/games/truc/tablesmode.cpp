@@ -0,0 +1,45 @@
+#include "headers/truc.h"
+#include "headers/botdecider.h"
+#include "headers/scheduler.h"
+#include "headers/seat.h"
+#include "headers/table.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+// Plays `count` bot tables of `rounds` rounds each as coroutines on a single
+// scheduler thread, table i dealt from stream (seed, i)
+int playTables(int count, long long rounds, const StrategyTable *strategy, uint64_t seed){
+    std::vector<Table> tables;
+    std::vector<BotDecider> bots;
+    std::vector<DeciderSeat> seats;
+    std::vector<Task<void>> games;
+    tables.reserve(count);
+    bots.reserve(count);
+    seats.reserve(count);
+    Scheduler scheduler;
+    for(int i=0;i<count;i++){
+        tables.emplace_back(seed, i);
+        bots.emplace_back(strategy, (TrucBot*)NULL, rounds);
+        seats.emplace_back(&bots[i]);
+        games.push_back(tables[i].play(seats[i], scheduler, 0));
+        scheduler.start(games[i]);
+    }
+    auto start = std::chrono::steady_clock::now();
+    long long resumes = scheduler.runReady();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    long long played = 0, wins = 0, loses = 0, cash = 0;
+    for(const Table &t: tables){
+        played += t.getRound();
+        wins += t.getWins();
+        loses += t.getLoses();
+        cash += t.getCash();
+    }
+    std::cout<<std::fixed<<std::setprecision(2);
+    std::cout<<"Tables:  "<<count<<" on one thread, "<<played<<" rounds ("<<resumes<<" resumes)\n";
+    std::cout<<"Wins:    "<<100.0*wins/(played>0 ? played : 1)<<" %\n";
+    std::cout<<"Loses:   "<<100.0*loses/(played>0 ? played : 1)<<" %\n";
+    std::cout<<"Cash:    "<<(double)cash/(count>0 ? count : 1)<<" per table\n";
+    std::cout<<"Time:    "<<secs<<" s ("<<(secs>0 ? played/secs/1e6 : 0.0)<<" M rounds/s)\n";
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include "headers/terminaldecider.h"
+#include "headers/color.h"
+#include "headers/input.h"
+#include <iostream>
+
+//////////////* Blackjack *////
+
+// W = Raise Bet | S = Decrease Bet | R = Done
+int TerminalDecider::chooseBet(int cash, int bet, int cardsLeft){
+    switch(toupper(Input::session().key())){
+        case 87: return BET_RAISE;
+        case 83: return BET_LOWER;
+        case 82: return BET_DONE;
+    }
+    return BET_NONE;
+}
+
+// H : Hit | S : Stand
+bool TerminalDecider::chooseHit(const Hand &player, Card up){
+    while(true){
+        int c = toupper(Input::session().key());
+        if(c==72) return true;
+        if(c==83) return false;
+    }
+}
+
+bool TerminalDecider::keepPlaying(){
+    char cont = Input::session().answer();
+    return cont!='N' && cont!='n';
+}
+
+//////////////* Truc *////
+
+// Shows the table and the seat's hand, then reads the number of a legal move
+uint8_t TerminalDecider::chooseTrucMove(const TrucState &s){
+    uint8_t moves[TrucState::MOVES];
+    int n = s.legalMoves(moves);
+    std::cout<<"\n"<<lightYellow<<"Score "<<(int)s.score[s.getTeam(s.turn)]<<" - "<<(int)s.score[1-s.getTeam(s.turn)]<<def<<"\tTable:";
+    for(int p=0;p<s.players;p++){
+        if(s.table[p]!=Card()){
+            std::cout<<" "<<s.table[p].getNumber()<<s.table[p].getSuit();
+        }
+    }
+    std::cout<<"\nYour cards:";
+    for(int i=0;i<TrucState::HAND_CARDS;i++){
+        if(!s.hasPlayed(s.turn, i)){
+            std::cout<<" "<<s.hands[s.turn][i].getNumber()<<s.hands[s.turn][i].getSuit();
+        }
+    }
+    if(s.phase==TrucState::RESPOND){
+        std::cout<<lightRed<<"\n"<<(s.pending==TrucState::TRUC ? "Truc" : "Envit")<<" level "<<(int)s.pendingLevel<<"!"<<def;
+    }
+    std::cout<<"\n";
+    for(int i=0;i<n;i++){
+        std::cout<<"["<<i+1<<"] "<<TrucState::moveName(moves[i]);
+        if(moves[i]<=TrucState::PLAY_THIRD){
+            std::cout<<" ("<<s.hands[s.turn][moves[i]].getNumber()<<s.hands[s.turn][moves[i]].getSuit()<<")";
+        }
+        std::cout<<"   ";
+    }
+    std::cout<<"\n";
+    while(true){
+        int c = Input::session().key()-'1';
+        if(c>=0 && c<n){
+            return moves[c];
+        }
+    }
+}
@@ -0,0 +1,527 @@
+#include "headers/tournament.h"
+#include "headers/botdecider.h"
+#include "headers/deck.h"
+#include "headers/rng.h"
+#include "headers/scheduler.h"
+#include "headers/seat.h"
+#include "headers/table.h"
+#include "headers/trucbot.h"
+#include "headers/workpool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <tuple>
+
+//////////////* Players *////
+
+// Random legal Truc moves
+class RandomDecider: public Decider{
+    private:
+        Rng rng;
+    public:
+        RandomDecider(uint64_t seed, uint64_t stream): rng(seed, stream) {}
+        int chooseBet(int cash, int bet, int cardsLeft){ return BET_DONE; }
+        bool chooseHit(const Hand &player, Card up){ return false; }
+        bool keepPlaying(){ return false; }
+        uint8_t chooseTrucMove(const TrucState &s){
+            uint8_t moves[TrucState::MOVES];
+            int n = s.legalMoves(moves);
+            return moves[rng.below(n)];
+        }
+};
+
+// Baseline cards, bids from a trained TrucCfr
+class CfrDecider: public Decider{
+    private:
+        const TrucCfr *cfr;
+        Rng rng;
+    public:
+        CfrDecider(const TrucCfr *c, uint64_t seed, uint64_t stream): cfr(c), rng(seed, stream) {}
+        int chooseBet(int cash, int bet, int cardsLeft){ return BET_DONE; }
+        bool chooseHit(const Hand &player, Card up){ return false; }
+        bool keepPlaying(){ return false; }
+        uint8_t chooseTrucMove(const TrucState &s){
+            uint8_t m = cfr->decide(s, rng);
+            if(m!=TrucCfr::PASS){
+                return m;
+            }
+            return s.phase==TrucState::RESPOND ? (uint8_t)TrucState::ACCEPT : (uint8_t)s.heuristicCard();
+        }
+};
+
+// BotDecider owning its TrucBot
+class MctsDecider: public BotDecider{
+    private:
+        std::unique_ptr<TrucBot> bot;
+    public:
+        MctsDecider(TrucBot *b): BotDecider(NULL, b, 0), bot(b) {}
+};
+
+// Blackjack: $5 bets, hits below a total, for a number of rounds
+class HitDecider: public Decider{
+    private:
+        int total;
+        long long rounds, played;
+    public:
+        HitDecider(int t, long long r): total(t), rounds(r), played(0) {}
+        int chooseBet(int cash, int bet, int cardsLeft){ return bet<5 && cash>=5 ? BET_RAISE : BET_DONE; }
+        bool chooseHit(const Hand &player, Card up){ return player.getSum()<total; }
+        bool keepPlaying(){ return ++played<rounds; }
+        uint8_t chooseTrucMove(const TrucState &s){ return s.heuristicCard(); }
+};
+
+//////////////* Set Up *////
+
+Tournament::Tournament(Format f, int swiss, int g, int p, int r, int t, uint64_t s){
+    format = f;
+    swissRounds = swiss>0 ? swiss : 1;
+    games = g>0 ? g : 1;
+    players = p==4 ? 4 : 2;
+    rounds = r>0 ? r : 1;
+    threads = t>0 ? t : 1;
+    seed = s;
+    game = TRUC;
+    resumed = 0;
+    steals = 0;
+}
+
+// Parses an entrant and loads its files; every entrant plays the same game
+bool Tournament::addEntrant(const std::string &spec, std::string &error){
+    Entrant e;
+    e.spec = spec;
+    e.value = 0;
+    size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    std::string arg = colon==std::string::npos ? "" : spec.substr(colon+1);
+    Game g = TRUC;
+    if(kind=="baseline"){
+        e.kind = BASELINE;
+    }
+    else if(kind=="random"){
+        e.kind = RANDOM;
+    }
+    else if(kind=="cfr"){
+        e.kind = CFR;
+        e.cfr = std::make_shared<TrucCfr>();
+        if(!e.cfr->load(arg)){
+            error = "could not load "+arg;
+            return false;
+        }
+    }
+    else if(kind=="mcts"){
+        e.kind = MCTS;
+        e.value = atoi(arg.c_str());
+    }
+    else if(kind=="chart"){
+        e.kind = CHART;
+        g = BLACKJACK;
+        e.chart = std::make_shared<StrategyTable>();
+        if(!e.chart->load(arg)){
+            error = "could not load "+arg;
+            return false;
+        }
+    }
+    else if(kind=="hit"){
+        e.kind = HIT;
+        g = BLACKJACK;
+        e.value = atoi(arg.c_str());
+    }
+    else{
+        error = "unknown entrant "+spec;
+        return false;
+    }
+    if(!entrants.empty() && g!=game){
+        error = spec+" doesn't play the same game as "+entrants[0].spec;
+        return false;
+    }
+    game = g;
+    entrants.push_back(e);
+    return true;
+}
+
+// Everything the results depend on (not the number of threads)
+std::string Tournament::describe() const {
+    std::ostringstream d;
+    d<<(game==TRUC ? "truc" : "blackjack")<<" "<<(format==ROUND_ROBIN ? "round-robin" : "swiss")<<" "<<swissRounds
+     <<" games "<<games<<" players "<<players<<" rounds "<<rounds<<" seed "<<seed;
+    for(const Entrant &e: entrants){
+        d<<" | "<<e.spec;
+    }
+    return d.str();
+}
+
+// Reads the batches of an earlier run with the same settings, then appends.
+// The file is written back first so that a batch torn by the interruption
+// is dropped rather than followed.
+/*
+ * File: "TRUCTN2", description length (uint32) and text, then one record of
+ * BATCH_BYTES per finished batch in the order they finished. Integers are
+ * little endian and written field by field, see encode().
+ */
+bool Tournament::open(const std::string &file, std::string &error){
+    path = file;
+    std::string description = describe();
+    std::ifstream f1(path, std::ios::in | std::ios::binary);
+    if(!f1.fail()){
+        char magic[8] = {0};
+        char length[4];
+        f1.read(magic, 7);
+        f1.read(length, 4);
+        uint32_t size = (uint8_t)length[0] | (uint8_t)length[1]<<8 | (uint8_t)length[2]<<16 | (uint32_t)(uint8_t)length[3]<<24;
+        std::string stored(size<4096 ? size : 0, '\0');
+        f1.read(&stored[0], stored.size());
+        if(!f1 || strcmp(magic, "TRUCTN2")!=0 || stored!=description){
+            error = path+" holds a different tournament";
+            return false;
+        }
+        char record[BATCH_BYTES];
+        while(f1.read(record, BATCH_BYTES)){
+            done.push_back(decode(record));
+        }
+        resumed = done.size();
+        f1.close();
+    }
+    checkpoint.open(path, std::ios::out | std::ios::binary);
+    std::string head = "TRUCTN2";
+    uint32_t size = description.size();
+    for(int i=0;i<4;i++){
+        head.push_back((char)(size>>(8*i)));
+    }
+    head += description;
+    for(const Batch &b: done){
+        encode(head, b);
+    }
+    checkpoint.write(head.data(), head.size());
+    checkpoint.flush();
+    if(checkpoint.fail()){
+        error = "could not write "+path;
+        return false;
+    }
+    return true;
+}
+
+void Tournament::record(const Batch &b){
+    std::string out;
+    encode(out, b);
+    std::lock_guard<std::mutex> lock(writing);
+    checkpoint.write(out.data(), out.size());
+    checkpoint.flush();
+}
+
+// Appends `bytes` little-endian bytes of v
+static void put(std::string &out, uint64_t v, int bytes){
+    for(int i=0;i<bytes;i++){
+        out.push_back((char)(v>>(8*i)));
+    }
+}
+
+static uint64_t get(const char *&p, int bytes){
+    uint64_t v = 0;
+    for(int i=0;i<bytes;i++){
+        v |= (uint64_t)(uint8_t)p[i]<<(8*i);
+    }
+    p += bytes;
+    return v;
+}
+
+// A batch as BATCH_BYTES bytes: round, a, b (16 bits), first, count (32 bits),
+// then both wins, draws and margin (64 bits)
+void Tournament::encode(std::string &out, const Batch &b){
+    put(out, b.round, 2);
+    put(out, b.a, 2);
+    put(out, b.b, 2);
+    put(out, b.first, 4);
+    put(out, b.count, 4);
+    put(out, b.result.wins[0], 8);
+    put(out, b.result.wins[1], 8);
+    put(out, b.result.draws, 8);
+    put(out, b.result.margin, 8);
+}
+
+Tournament::Batch Tournament::decode(const char *p){
+    Batch b;
+    b.round = get(p, 2);
+    b.a = get(p, 2);
+    b.b = get(p, 2);
+    b.first = get(p, 4);
+    b.count = get(p, 4);
+    b.result.wins[0] = get(p, 8);
+    b.result.wins[1] = get(p, 8);
+    b.result.draws = get(p, 8);
+    b.result.margin = get(p, 8);
+    return b;
+}
+
+//////////////* Playing *////
+
+std::unique_ptr<Decider> Tournament::makeDecider(int e, uint64_t stream){
+    const Entrant &en = entrants[e];
+    switch(en.kind){
+        case RANDOM: return std::unique_ptr<Decider>(new RandomDecider(seed, stream));
+        case CFR: return std::unique_ptr<Decider>(new CfrDecider(en.cfr.get(), seed, stream));
+        case MCTS: return std::unique_ptr<Decider>(new MctsDecider(new TrucBot(1, en.value, seed+stream)));
+        case CHART: return std::unique_ptr<Decider>(new BotDecider(en.chart.get(), NULL, rounds));
+        case HIT: return std::unique_ptr<Decider>(new HitDecider(en.value, rounds));
+        default: return std::unique_ptr<Decider>(new BotDecider(NULL, NULL, 0));
+    }
+}
+
+// Plays a batch on `worker`. Truc players get random streams of their own
+// for the batch, so results don't depend on the worker; only the searchers
+// of mcts players (timed anyway) are kept per worker.
+Tournament::Result Tournament::playBatch(int worker, const Batch &b){
+    Result r = {{0, 0}, 0, 0};
+    std::unique_ptr<Decider> own[2];
+    Decider *sides[2] = {NULL, NULL};
+    if(game==TRUC){
+        int entrant[2] = {b.a, b.b};
+        for(int i=0;i<2;i++){
+            if(entrants[entrant[i]].kind==MCTS){
+                sides[i] = seats[worker][entrant[i]].get();
+                continue;
+            }
+            uint64_t stream = (1ULL<<63) ^ ((uint64_t)b.round<<48) ^ ((uint64_t)b.a<<36) ^ ((uint64_t)b.b<<24) ^ ((uint64_t)b.first<<1) ^ i;
+            own[i] = makeDecider(entrant[i], stream);
+            sides[i] = own[i].get();
+        }
+    }
+    for(uint32_t g=b.first;g<b.first+b.count;g++){
+        if(game==TRUC){
+            // Duplicate: games 2k and 2k+1 deal the same cards with the sides swapped
+            int side = g%2;
+            Decider *teams[2];
+            teams[side] = sides[0];
+            teams[1-side] = sides[1];
+            Deck deck(Deck::SPANISH);
+            deck.seed(seed, g/2);
+            TrucState s;
+            s.newGame(players, 24);
+            int mano = 0;
+            uint64_t hand = 0;
+            while(!s.isGameOver()){
+                deck.setHand(hand++);
+                s.dealHand(deck, mano);
+                while(!s.isHandOver()){
+                    s.apply(teams[s.getTeam(s.turn)]->chooseTrucMove(s));
+                }
+                mano = (mano+1)%players;
+            }
+            r.wins[s.getGameWinner()==side ? 0 : 1]++;
+            r.margin += (int)s.score[side]-(int)s.score[1-side];
+        }
+        else{
+            // Both play a session on the same table stream
+            int cash[2];
+            int entrant[2] = {b.a, b.b};
+            for(int i=0;i<2;i++){
+                std::unique_ptr<Decider> d = makeDecider(entrant[i], g);
+                DeciderSeat seat(d.get());
+                Table table(seed, g);
+                Scheduler scheduler;
+                Task<void> session = table.play(seat, scheduler, 0);
+                scheduler.start(session);
+                scheduler.runReady();
+                cash[i] = table.getCash();
+            }
+            if(cash[0]!=cash[1]){
+                r.wins[cash[0]>cash[1] ? 0 : 1]++;
+            }
+            else{
+                r.draws++;
+            }
+            r.margin += cash[0]-cash[1];
+        }
+    }
+    return r;
+}
+
+// Plays every pairing of a round, skipping the batches already in the file
+void Tournament::playRound(int round, const std::vector<std::pair<int,int> > &pairings){
+    const int BATCH = 16;
+    std::map<std::tuple<int,int,int,uint32_t>, const Batch*> known;
+    for(const Batch &b: done){
+        known[std::make_tuple((int)b.round, (int)b.a, (int)b.b, b.first)] = &b;
+    }
+    std::vector<Batch> batches;
+    std::vector<int> jobs;
+    for(const std::pair<int,int> &p: pairings){
+        for(int first=0;first<games;first+=BATCH){
+            Batch b = {(uint16_t)round, (uint16_t)p.first, (uint16_t)p.second, (uint32_t)first,
+                       (uint32_t)std::min(BATCH, games-first), {{0, 0}, 0, 0}};
+            auto it = known.find(std::make_tuple(round, p.first, p.second, b.first));
+            if(it!=known.end() && it->second->count==b.count){
+                b.result = it->second->result;
+            }
+            else{
+                jobs.push_back(batches.size());
+            }
+            batches.push_back(b);
+        }
+    }
+    WorkPool pool(threads);
+    pool.run(jobs, [this, &batches](int worker, int job){
+        batches[job].result = playBatch(worker, batches[job]);
+        record(batches[job]);
+    });
+    steals += pool.getSteals();
+    // Totals, and the match points of the round for Swiss
+    std::vector<Result> match(pairings.size(), Result{{0, 0}, 0, 0});
+    for(const Batch &b: batches){
+        Result &t = pair(b.a, b.b);
+        t.wins[0] += b.result.wins[0];
+        t.wins[1] += b.result.wins[1];
+        t.draws += b.result.draws;
+        t.margin += b.result.margin;
+        for(size_t i=0;i<pairings.size();i++){
+            if(pairings[i].first==b.a && pairings[i].second==b.b){
+                match[i].wins[0] += b.result.wins[0];
+                match[i].wins[1] += b.result.wins[1];
+            }
+        }
+    }
+    for(size_t i=0;i<pairings.size();i++){
+        long long a = match[i].wins[0], b = match[i].wins[1];
+        points[pairings[i].first] += a>b ? 1.0 : a==b ? 0.5 : 0.0;
+        points[pairings[i].second] += b>a ? 1.0 : a==b ? 0.5 : 0.0;
+    }
+}
+
+// Swiss pairing: by points, each entrant meets the next one down it hasn't
+// met yet (or the next one at all); with an odd field the last one sits out
+// and takes a point
+std::vector<std::pair<int,int> > Tournament::swissPairings(int round){
+    int n = entrants.size();
+    std::vector<int> order(n);
+    for(int i=0;i<n;i++){
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](int x, int y){ return points[x]>points[y]; });
+    std::vector<bool> paired(n, false);
+    std::vector<std::pair<int,int> > pairings;
+    for(int i=0;i<n;i++){
+        int a = order[i];
+        if(paired[a]){
+            continue;
+        }
+        int partner = -1;
+        for(int j=i+1;j<n;j++){
+            int b = order[j];
+            if(paired[b]){
+                continue;
+            }
+            const Result &r = pair(std::min(a, b), std::max(a, b));
+            bool met = r.wins[0]+r.wins[1]+r.draws>0;
+            if(partner<0){
+                partner = b;
+            }
+            if(!met){
+                partner = b;
+                break;
+            }
+        }
+        if(partner<0){
+            points[a] += 1.0;
+            continue;
+        }
+        paired[a] = paired[partner] = true;
+        pairings.push_back(std::make_pair(std::min(a, partner), std::max(a, partner)));
+    }
+    return pairings;
+}
+
+void Tournament::run(){
+    int n = entrants.size();
+    pairs.assign(n*n, Result{{0, 0}, 0, 0});
+    points.assign(n, 0.0);
+    seats.resize(threads);
+    for(int w=0;w<threads;w++){
+        for(int e=0;e<n;e++){
+            seats[w].push_back(entrants[e].kind==MCTS ? makeDecider(e, ((uint64_t)w<<32)+e) : NULL);
+        }
+    }
+    if(format==ROUND_ROBIN){
+        std::vector<std::pair<int,int> > pairings;
+        for(int a=0;a<n;a++){
+            for(int b=a+1;b<n;b++){
+                pairings.push_back(std::make_pair(a, b));
+            }
+        }
+        playRound(0, pairings);
+        return;
+    }
+    for(int r=0;r<swissRounds;r++){
+        playRound(r, swissPairings(r));
+    }
+}
+
+//////////////* Ratings *////
+
+// Bradley-Terry strengths by minorization-maximization, with one virtual win
+// and loss against an average player each so that unbeaten or winless
+// entrants stay finite; a draw counts half a win for each side
+std::vector<double> Tournament::ratings() const {
+    int n = entrants.size();
+    std::vector<double> strength(n, 1.0), score(n, 1.0);
+    for(int a=0;a<n;a++){
+        for(int b=a+1;b<n;b++){
+            const Result &r = pairs[a*n+b];
+            score[a] += r.wins[0]+0.5*r.draws;
+            score[b] += r.wins[1]+0.5*r.draws;
+        }
+    }
+    for(int it=0;it<1000;it++){
+        std::vector<double> next(n);
+        for(int a=0;a<n;a++){
+            double d = 2.0/(strength[a]+1.0);
+            for(int b=0;b<n;b++){
+                if(b==a){
+                    continue;
+                }
+                const Result &r = pairs[std::min(a, b)*n+std::max(a, b)];
+                d += (r.wins[0]+r.wins[1]+r.draws)/(strength[a]+strength[b]);
+            }
+            next[a] = score[a]/d;
+        }
+        strength = next;
+    }
+    std::vector<double> elo(n);
+    for(int a=0;a<n;a++){
+        elo[a] = 1500.0+400.0*std::log10(strength[a]);
+    }
+    return elo;
+}
+
+void Tournament::print(std::ostream &out) const {
+    int n = entrants.size();
+    out<<std::fixed<<std::setprecision(1);
+    for(int a=0;a<n;a++){
+        for(int b=a+1;b<n;b++){
+            const Result &r = pairs[a*n+b];
+            long long played = r.wins[0]+r.wins[1]+r.draws;
+            if(played==0){
+                continue;
+            }
+            out<<entrants[a].spec<<" vs "<<entrants[b].spec<<": "<<r.wins[0]<<"-"<<r.draws<<"-"<<r.wins[1]
+               <<" ("<<100.0*(r.wins[0]+0.5*r.draws)/played<<" %), margin "<<(double)r.margin/played<<" per game\n";
+        }
+    }
+    std::vector<double> elo = ratings();
+    std::vector<int> order(n);
+    for(int i=0;i<n;i++){
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&elo](int x, int y){ return elo[x]>elo[y]; });
+    out<<"\nRank  Elo     "<<(format==SWISS ? "Points  " : "")<<"Entrant\n";
+    for(int i=0;i<n;i++){
+        int e = order[i];
+        out<<std::setw(4)<<i+1<<"  "<<std::setw(6)<<elo[e]<<"  ";
+        if(format==SWISS){
+            out<<std::setw(6)<<points[e]<<"  ";
+        }
+        out<<entrants[e].spec<<"\n";
+    }
+}
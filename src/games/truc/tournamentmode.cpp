@@ -0,0 +1,34 @@
+#include "headers/truc.h"
+#include "headers/tournament.h"
+#include <iostream>
+
+// Plays a tournament between `specs`, resuming from `path` when it holds an
+// interrupted run of the same tournament
+int tournament(const std::string &path, const std::vector<std::string> &specs, int swiss, int games, int players, long long rounds,
+               int threads, uint64_t seed){
+    Tournament t(swiss>0 ? Tournament::SWISS : Tournament::ROUND_ROBIN, swiss, games, players, rounds, threads, seed);
+    std::string error;
+    for(const std::string &spec: specs){
+        if(!t.addEntrant(spec, error)){
+            std::cerr<<error<<"\n";
+            return 1;
+        }
+    }
+    if(specs.size()<2){
+        std::cerr<<"A tournament needs two entrants or more\n";
+        return 1;
+    }
+    if(!t.open(path, error)){
+        std::cerr<<error<<"\n";
+        return 1;
+    }
+    if(t.getResumed()>0){
+        std::cout<<"Resuming "<<path<<": "<<t.getResumed()<<" batches already played\n"<<std::flush;
+    }
+    auto start = std::chrono::steady_clock::now();
+    t.run();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+    t.print(std::cout);
+    std::cout<<"\nTime:    "<<std::setprecision(2)<<secs<<" s ("<<threads<<" threads, "<<t.getSteals()<<" batches stolen)\n";
+    return 0;
+}
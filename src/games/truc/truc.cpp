@@ -1,14 +1,192 @@
 #include "headers/truc.h"
+#include "headers/botdecider.h"
+#include "headers/dealerodds.h"
+#include "headers/scripteddecider.h"
+#include "headers/selftest.h"
+#include "headers/terminaldecider.h"
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
 #include <time.h>
 
-int main(){
+// Parses the options and runs the mode they ask for; the modes themselves
+// are declared in truc.h, one translation unit each
 
-    srand(time(NULL));          // To seed rand() function across all files
+int usage(){
+    std::cerr<<"Usage: truc [--seed S] [--selftest | --simulate N | --shoes N | --bench N | --solve | --equity-gen FILE | --truc-match N | --dd-solve FILE |\n"
+             <<"             --cfr-train N | --compile SRC | --serve ADDR | --connect ADDR | --tables N |\n"
+             <<"             --tournament FILE --entrant SPEC...] [--threads T] [--decks D] [--samples N] [--players P]\n"
+             <<"            [--think MS] [--cfr FILE] [--equity FILE] [--out FILE] [--strategy FILE | --script FILE | --human]\n"
+             <<"            [--rounds N] [--penetration P] [--clients N] [--idle MS] [--games N] [--swiss R] [--antithetic]\n"
+             <<"            [--precision H | --sprt M0,M1]\n";
+    return 1;
+}
+
+int main(int argc, char *argv[]){
+
+    long long hands = 0;                                // Hands to simulate (0 = interactive)
+    long long benchHands = 0;                           // Hands per loop for --bench
+    long long shoes = 0;                                // Shoes to simulate
+    double penetration = 0.75;                          // Share of each shoe dealt
+    int threads = std::thread::hardware_concurrency();  // Worker threads for --simulate
+    uint64_t seed = time(NULL);                         // Seed of every random stream
+    bool solveChart = false;                            // Print the basic strategy chart
+    bool selfTest = false;                              // Run the self checks
+    int decks = 1;                                      // Decks in the shoe for --solve
+    std::string equityPath;                             // Equity table to generate
+    int samples = 2000;                                 // Deals per hand and seat for --equity-gen
+    int games = 0;                                      // Truc games for --truc-match
+    int players = 4;                                    // Truc players (2 or 4)
+    int thinkMs = 100;                                  // Bot thinking time per decision
+    std::string dealsPath;                              // Hand history for --dd-solve
+    long long cfrIterations = 0;                        // Iterations for --cfr-train
+    std::string cfrPath;                                // Bidding strategy file
+    std::string equityFile;                             // Equity table the bot bids from
+    std::string sourcePath;                             // Strategy description for --compile
+    std::string outPath;                                // Compiled strategy to write
+    std::string strategyPath;                           // Compiled strategy playing the game
+    std::string scriptPath;                             // Scripted decisions playing the game
+    bool human = false;                                 // Human on team 1 of --truc-match
+    long long rounds = 1000;                            // Blackjack rounds for a bot seat
+    std::string serveAddress;                           // Address to host tables on
+    std::string connectAddress;                         // Server to play on
+    int clients = 0;                                    // Bot connections for --connect
+    int idleMs = 60000;                                 // Idle time before the server plays for a player
+    int tables = 0;                                     // Bot tables for --tables
+    std::string tournamentPath;                         // Checkpoint and results of --tournament
+    std::vector<std::string> entrants;                  // Tournament entrants
+    int swiss = 0;                                      // Swiss rounds (0 = round robin)
+    int pairingGames = 100;                             // Games per tournament pairing
+    bool antithetic = false;                            // Mirror half the shuffles of a comparison
+    StoppingRule rule;                                  // Early stop of --simulate, --shoes and --truc-match
 
-    Game game;                  // Constructs object GAME
-    game.beginMenu(false, "");  // Begins with the interface
+    for(int i=1;i<argc;i++){
+        if(strcmp(argv[i], "--solve")==0){
+            solveChart = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--antithetic")==0){
+            antithetic = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--selftest")==0){
+            selfTest = true;
+            continue;
+        }
+        if(strcmp(argv[i], "--human")==0){
+            human = true;
+            continue;
+        }
+        // Every other option takes a value: check it is there before reading it
+        if(i+1>=argc) return usage();
+        const char *option = argv[i];
+        const char *value = argv[++i];
+        if(strcmp(option, "--simulate")==0) hands = atoll(value);
+        else if(strcmp(option, "--bench")==0) benchHands = atoll(value);
+        else if(strcmp(option, "--shoes")==0) shoes = atoll(value);
+        else if(strcmp(option, "--penetration")==0) penetration = atof(value);
+        else if(strcmp(option, "--decks")==0) decks = atoi(value);
+        else if(strcmp(option, "--equity-gen")==0) equityPath = value;
+        else if(strcmp(option, "--samples")==0) samples = atoi(value);
+        else if(strcmp(option, "--truc-match")==0) games = atoi(value);
+        else if(strcmp(option, "--players")==0) players = atoi(value);
+        else if(strcmp(option, "--think")==0) thinkMs = atoi(value);
+        else if(strcmp(option, "--dd-solve")==0) dealsPath = value;
+        else if(strcmp(option, "--cfr-train")==0) cfrIterations = atoll(value);
+        else if(strcmp(option, "--cfr")==0) cfrPath = value;
+        else if(strcmp(option, "--equity")==0) equityFile = value;
+        else if(strcmp(option, "--compile")==0) sourcePath = value;
+        else if(strcmp(option, "--out")==0) outPath = value;
+        else if(strcmp(option, "--strategy")==0) strategyPath = value;
+        else if(strcmp(option, "--script")==0) scriptPath = value;
+        else if(strcmp(option, "--rounds")==0) rounds = atoll(value);
+        else if(strcmp(option, "--serve")==0) serveAddress = value;
+        else if(strcmp(option, "--connect")==0) connectAddress = value;
+        else if(strcmp(option, "--clients")==0) clients = atoi(value);
+        else if(strcmp(option, "--idle")==0) idleMs = atoi(value);
+        else if(strcmp(option, "--tables")==0) tables = atoi(value);
+        else if(strcmp(option, "--tournament")==0) tournamentPath = value;
+        else if(strcmp(option, "--entrant")==0) entrants.push_back(value);
+        else if(strcmp(option, "--swiss")==0) swiss = atoi(value);
+        else if(strcmp(option, "--games")==0) pairingGames = atoi(value);
+        else if(strcmp(option, "--precision")==0) rule.setPrecision(atof(value));
+        else if(strcmp(option, "--sprt")==0){
+            double m0, m1;
+            if(sscanf(value, "%lf,%lf", &m0, &m1)!=2 || m0==m1) return usage();
+            rule.setSprt(m0, m1, 0.05, 0.05);
+        }
+        else if(strcmp(option, "--threads")==0) threads = atoi(value);
+        else if(strcmp(option, "--seed")==0) seed = strtoull(value, NULL, 10);
+        else return usage();
+    }
+    if(!serveAddress.empty()){
+        return serve(serveAddress, threads>0 ? threads : 1, idleMs, seed);
+    }
+    if(!connectAddress.empty()){
+        return joinServer(connectAddress, clients, rounds);
+    }
+    if(selfTest){
+        return SelfTest::run(std::cout, seed)==0 ? 0 : 1;
+    }
+    if(!tournamentPath.empty()){
+        return tournament(tournamentPath, entrants, swiss, pairingGames, players, rounds, threads>0 ? threads : 1, seed);
+    }
+    if(benchHands>0){
+        return bench(benchHands, seed);
+    }
+    if(!equityPath.empty()){
+        return generateEquity(equityPath, samples>0 ? samples : 1, threads>0 ? threads : 1, seed);
+    }
+    if(!dealsPath.empty()){
+        return solveDeals(dealsPath, threads>0 ? threads : 1);
+    }
+    if(!sourcePath.empty()){
+        if(outPath.empty()) return usage();
+        return compileStrategy(sourcePath, outPath);
+    }
+    if(cfrIterations>0){
+        if(cfrPath.empty()) return usage();
+        return trainCfr(cfrPath, cfrIterations, threads>0 ? threads : 1, seed);
+    }
+    ScriptedDecider script;
+    if(!scriptPath.empty() && !script.load(scriptPath)){
+        std::cerr<<"Could not open "<<scriptPath<<"\n";
+        return 1;
+    }
+    if(games>0){
+        BotDecider baseline(NULL, NULL, 0);
+        TerminalDecider terminal;
+        Decider *opponent = human ? (Decider*)&terminal : !scriptPath.empty() ? (Decider*)&script : (Decider*)&baseline;
+        return trucMatch(games, players==2 ? 2 : 4, thinkMs, threads>0 ? threads : 1, seed, cfrPath, equityFile, opponent, rule);
+    }
+    if(solveChart){
+        if(decks<0 || decks>Composition::MAX_DECKS){
+            std::cerr<<"--solve takes 0 (an infinite shoe) to "<<Composition::MAX_DECKS<<" decks\n";
+            return 1;
+        }
+        return solve(decks>0 ? decks : 0, threads>0 ? threads : 1, outPath);
+    }
+    if(shoes>0){
+        return simulateShoes(shoes, decks>0 ? decks : 1, penetration, threads>0 ? threads : 1, seed, rule);
+    }
+    if(hands>0 && !entrants.empty()){
+        if(entrants.size()!=2) return usage();
+        return compare(hands, entrants, antithetic, threads>0 ? threads : 1, seed, rule);
+    }
+    if(hands>0){
+        return simulate(hands, threads>0 ? threads : 1, seed, rule);
+    }
 
-    return 0;                   // Return integer value at end of main()
+    StrategyTable strategy;
+    if(!strategyPath.empty() && !strategy.load(strategyPath)){
+        std::cerr<<"Could not load "<<strategyPath<<"\n";
+        return 1;
+    }
+    if(tables>0){
+        return playTables(tables, rounds, strategyPath.empty() ? NULL : &strategy, seed);
+    }
+    return play(seed, rounds, strategyPath.empty() ? NULL : &strategy, scriptPath.empty() ? NULL : &script);
 
 }
@@ -0,0 +1,292 @@
+#include "headers/trucbot.h"
+#include "headers/truchands.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+static const float EXPLORATION = 0.7f;
+static const int MAX_DEPTH = 64;
+static const double RAISE_EQUITY = 0.7;     // Call or raise the truc from this equity up
+static const double ENVIT_CALL = 0.7;       // Call or raise the envit from this win chance up
+
+static long long nowMicros(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//////////////* Constructor *////
+
+TrucBot::TrucBot(int t, int ms, uint64_t s){
+    threads = t>0 ? t : 1;
+    deadlineMs = ms;
+    seed = s;
+    decisions = 0;
+    lastPlayouts = 0;
+    bidding = NULL;
+    equity = NULL;
+    pools.resize(threads);
+}
+
+//////////////* Decision *////
+
+// Best move for the seat in s.turn, found before the deadline. Always returns
+// a legal move, even if the deadline allowed no playout at all.
+uint8_t TrucBot::decide(const TrucState &s){
+    uint8_t moves[TrucState::MOVES];
+    int n = s.legalMoves(moves);
+    if(n<=1){
+        return n==1 ? moves[0] : 0;
+    }
+    // Bids inside the bidding abstraction are O(1) lookups, a pass leaves the card to the search
+    bool cardsOnly = false;
+    if(bidding!=NULL){
+        Rng rng(seed, threads);
+        rng.setHand(decisions);
+        uint8_t bid = bidding->decide(s, rng);
+        if(bid!=TrucCfr::PASS && s.isLegal(bid)){
+            decisions++;
+            lastPlayouts = 0;
+            return bid;
+        }
+        cardsOnly = bid==TrucCfr::PASS && s.phase==TrucState::PLAY && bidding->infosetOf(s)>=0;
+    }
+    // Without a table, or once a card is played, bids are searched like cards
+    if(equity!=NULL && !cardsOnly){
+        uint8_t bid = tableBid(s);
+        if(bid!=TrucState::MOVES){
+            decisions++;
+            lastPlayouts = 0;
+            return bid;
+        }
+        cardsOnly = s.phase==TrucState::PLAY && s.baza==0 && (s.played>>(s.turn*TrucState::HAND_CARDS)&7)==0;
+    }
+    long long deadline = nowMicros()+(long long)deadlineMs*1000;
+    std::vector<std::vector<uint32_t> > visits(threads, std::vector<uint32_t>(TrucState::MOVES, 0));
+    std::vector<long long> playouts(threads, 0);
+    std::vector<std::thread> workers;
+    for(int t=1;t<threads;t++){
+        workers.push_back(std::thread(&TrucBot::search, this, t, std::cref(s), deadline, visits[t].data(), &playouts[t]));
+    }
+    search(0, s, deadline, visits[0].data(), &playouts[0]);
+    for(std::thread &w: workers){
+        w.join();
+    }
+    decisions++;
+    lastPlayouts = 0;
+    uint32_t total[TrucState::MOVES] = {0};
+    for(int t=0;t<threads;t++){
+        lastPlayouts += playouts[t];
+        for(int m=0;m<TrucState::MOVES;m++){
+            total[m] += visits[t][m];
+        }
+    }
+    uint8_t best = s.phase==TrucState::PLAY ? (uint8_t)s.heuristicCard() : moves[0];
+    for(int i=0;i<n;i++){
+        if(cardsOnly && moves[i]>TrucState::PLAY_THIRD){
+            continue;
+        }
+        if(total[moves[i]]>total[best]){
+            best = moves[i];
+        }
+    }
+    return best;
+}
+
+//////////////* Table Bids *////
+
+// Chance that a random 3-card hand has an envit below `envit`, ties counted
+// as half, from the hand table
+static double envitBelow(int envit){
+    static const struct Cdf{
+        double below[41];
+        Cdf(){
+            int count[41] = {0};
+            for(const TrucHandInfo &h: TrucHands::table){
+                count[h.envit]++;
+            }
+            int under = 0;
+            for(int e=0;e<=40;e++){
+                below[e] = (under+count[e]/2.0)/TrucHands::HANDS;
+                under += count[e];
+            }
+        }
+    } cdf;
+    return cdf.below[envit<=40 ? envit : 40];
+}
+
+// Bid from the equity table while `turn` still holds its three cards, or
+// MOVES to leave the move to the search. Answers compare the expected
+// points of accepting, (2e-1)*value, with the points lost by rejecting.
+uint8_t TrucBot::tableBid(const TrucState &s) const{
+    int seat = s.turn;
+    if(s.baza>0 || (s.played>>(seat*TrucState::HAND_CARDS)&7)!=0){
+        return TrucState::MOVES;
+    }
+    int order = (seat-s.mano+s.players)%s.players;
+    double e = equity->get(s.hands[seat], s.players, order);
+    double below = envitBelow(TrucState::envitOf(s.hands[seat]));
+    double envit = s.players==4 ? below*below : below;     // Beat every opponent
+    if(s.phase==TrucState::RESPOND && s.pending==TrucState::TRUC){
+        if(e>=RAISE_EQUITY && s.isLegal(TrucState::TRUC)){
+            return TrucState::TRUC;
+        }
+        int value = s.pendingLevel==TrucState::JOC_FORA ? s.target-s.score[s.getTeam(seat)] : TrucState::trucValue(s.pendingLevel);
+        int lost = TrucState::trucValue(s.pendingLevel-1);
+        return (2*e-1)*value>=-lost ? TrucState::ACCEPT : TrucState::REJECT;
+    }
+    if(s.phase==TrucState::RESPOND && s.pending==TrucState::ENVIT){
+        if(envit>=ENVIT_CALL && s.isLegal(TrucState::ENVIT)){
+            return TrucState::ENVIT;
+        }
+        int value = s.pendingLevel==TrucState::FALTA_ENVIT ? s.getFalta() : TrucState::envitValue(s.pendingLevel);
+        int lost = s.envitLevel==0 ? 1 : TrucState::envitValue(s.envitLevel);
+        return (2*envit-1)*value>=-lost ? TrucState::ACCEPT : TrucState::REJECT;
+    }
+    if(s.phase==TrucState::PLAY){
+        if(envit>=ENVIT_CALL && s.isLegal(TrucState::ENVIT)){
+            return TrucState::ENVIT;
+        }
+        if(e>=RAISE_EQUITY && s.isLegal(TrucState::TRUC)){
+            return TrucState::TRUC;
+        }
+    }
+    return TrucState::MOVES;
+}
+
+//////////////* Search *////
+
+// Grows one tree from `root` until the deadline, writes the root visits per move
+void TrucBot::search(int worker, const TrucState &root, long long deadline, uint32_t visits[TrucState::MOVES], long long *playouts){
+    std::vector<Node> &pool = pools[worker];
+    if(pool.capacity()==0){
+        pool.reserve(MAX_NODES);
+    }
+    pool.clear();
+    Node r = {-1, -1, 0, 0, 0.0f, 0, root.turn};
+    pool.push_back(r);
+    Rng rng(seed, worker);
+    rng.setHand(decisions);
+    int me = root.turn;
+    long long done = 0;
+    int path[MAX_DEPTH];
+    while(true){
+        if((done&63)==0 && nowMicros()>=deadline){
+            break;
+        }
+        TrucState s = root;
+        determinize(s, me, rng);
+        int node = 0, depth = 0;
+        path[depth++] = 0;
+        // Selection and expansion over the moves legal in this deal
+        while(!s.isHandOver() && depth<MAX_DEPTH){
+            uint8_t moves[TrucState::MOVES];
+            int n = s.legalMoves(moves);
+            int32_t child[TrucState::MOVES];
+            int untried[TrucState::MOVES], nUntried = 0;
+            for(int i=0;i<n;i++){
+                child[i] = -1;
+                for(int32_t c=pool[node].firstChild;c>=0;c=pool[c].nextSibling){
+                    if(pool[c].move==moves[i]){
+                        child[i] = c;
+                        break;
+                    }
+                }
+                if(child[i]<0){
+                    untried[nUntried++] = i;
+                }
+            }
+            if(nUntried>0 && pool.size()<MAX_NODES){
+                int i = untried[rng.below(nUntried)];
+                Node c = {-1, pool[node].firstChild, 0, 0, 0.0f, moves[i], s.turn};
+                pool.push_back(c);
+                pool[node].firstChild = pool.size()-1;
+                node = pool.size()-1;
+                s.apply(moves[i]);
+                path[depth++] = node;
+                break;
+            }
+            int best = -1;
+            float bestScore = -1.0f;
+            for(int i=0;i<n;i++){
+                if(child[i]<0){
+                    continue;
+                }
+                Node &c = pool[child[i]];
+                c.available++;
+                float score = c.visits==0 ? 1e9f : c.reward/c.visits+EXPLORATION*std::sqrt(std::log((float)c.available)/c.visits);
+                if(score>bestScore){
+                    bestScore = score;
+                    best = child[i];
+                }
+            }
+            if(best<0){
+                break;
+            }
+            node = best;
+            s.apply(pool[node].move);
+            path[depth++] = node;
+        }
+        // Playout to the end of the hand
+        while(!s.isHandOver()){
+            s.apply(rolloutMove(s, rng));
+        }
+        for(int d=0;d<depth;d++){
+            Node &p = pool[path[d]];
+            p.visits++;
+            p.reward += reward(s, p.seat);
+        }
+        done++;
+    }
+    for(int32_t c=pool[0].firstChild;c>=0;c=pool[c].nextSibling){
+        visits[pool[c].move] = pool[c].visits;
+    }
+    *playouts = done;
+}
+
+// Deals the cards `seat` can't see at random among the ones not in sight
+void TrucBot::determinize(TrucState &s, int seat, Rng &rng){
+    uint64_t seen = 0;
+    for(int p=0;p<s.players;p++){
+        for(int i=0;i<TrucState::HAND_CARDS;i++){
+            if(p==seat || s.hasPlayed(p, i)){
+                seen |= 1ULL<<s.hands[p][i].getCode();
+            }
+        }
+    }
+    Card unknown[TrucHands::CARDS];
+    int n = 0;
+    for(int d=0;d<TrucHands::CARDS;d++){
+        Card c = TrucHands::cardAt(d);
+        if(!((seen>>c.getCode())&1)){
+            unknown[n++] = c;
+        }
+    }
+    for(int p=0;p<s.players;p++){
+        if(p==seat){
+            continue;
+        }
+        for(int i=0;i<TrucState::HAND_CARDS;i++){
+            if(!s.hasPlayed(p, i)){
+                int k = rng.below(n);
+                s.hands[p][i] = unknown[k];
+                unknown[k] = unknown[--n];
+            }
+        }
+    }
+}
+
+// Fast playout policy: heuristic card play, random answers, no new bids
+uint8_t TrucBot::rolloutMove(const TrucState &s, Rng &rng){
+    if(s.phase==TrucState::RESPOND){
+        return rng.below(2) ? TrucState::ACCEPT : TrucState::REJECT;
+    }
+    return s.heuristicCard();
+}
+
+// Reward in [0, 1] for the team of `seat`, from the points won this hand
+float TrucBot::reward(const TrucState &s, int seat){
+    int team = s.getTeam(seat);
+    float diff = (float)(s.handPoints[team]-s.handPoints[1-team])/6.0f;
+    if(diff>1.0f) diff = 1.0f;
+    if(diff<-1.0f) diff = -1.0f;
+    return 0.5f+0.5f*diff;
+}
@@ -0,0 +1,402 @@
+#include "headers/truccfr.h"
+#include "headers/doubledummy.h"
+#include "headers/truchands.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+static const char CFR_MAGIC[8] = "TRUCCF1";
+
+struct CfrHeader{
+    char magic[8];
+    int32_t buckets;
+    int32_t nodes;
+    int32_t actions;
+    int32_t reserved;
+    int64_t iterations;
+    int64_t batches;
+};
+
+//////////////* Constructor *////
+
+// Builds the betting tree and the position lookup, with zeroed regrets
+TrucCfr::TrucCfr(){
+    for(int k=0;k<KEYS;k++){
+        nodeOf[k] = -1;
+    }
+    nodes.reserve(256);
+    buildEnvit(0, 0, 0);
+    regret.assign((size_t)getInfosets()*MAX_ACTIONS, 0.0f);
+    strategySum.assign((size_t)getInfosets()*MAX_ACTIONS, 0.0f);
+    iterations = 0;
+    batches = 0;
+}
+
+//////////////* Betting Tree *////
+
+// Index in nodeOf of a decision position. Stage 0 is the envit round, stage 1
+// the truc round after envit outcome `envitLeaf`.
+int TrucCfr::key(int stage, int envitLeaf, int toAct, int pending, int passes){
+    return (((stage*10+envitLeaf)*2+toAct)*4+pending)*2+passes;
+}
+
+// Envit round: P0 may call, then P1. An envit can be raised once to torne.
+// Outcomes are numbered as envitLeafOf() does: 0 none, 1-4 rejected
+// (1 + team*2 + torne), 5-8 accepted (5 + last raiser*2 + torne).
+int TrucCfr::buildEnvit(int toAct, int pending, int passes){
+    int id = nodes.size();
+    nodes.push_back(Node());
+    nodeOf[key(0, 0, toAct, pending, passes)] = id;
+    Node n = {};
+    n.player = toAct;
+    n.envitFixedTeam = -1;
+    n.trucFixedTeam = -1;
+    Node outcome = n;
+    int children[MAX_ACTIONS], count = 0;
+    if(pending==0){
+        n.action[count] = PASS;
+        children[count++] = passes==1 ? buildTruc(0, outcome, 0, 0, 0) : buildEnvit(1-toAct, 0, passes+1);
+        n.action[count] = TrucState::ENVIT;
+        children[count++] = buildEnvit(1-toAct, 1, 0);
+    }
+    else{
+        int raiser = 1-toAct;
+        outcome.envitFixedTeam = raiser;
+        outcome.envitPoints = pending==1 ? 1 : TrucState::envitValue(1);
+        n.action[count] = TrucState::REJECT;
+        children[count++] = buildTruc(1+raiser*2+(pending==2), outcome, 0, 0, 0);
+        outcome.envitFixedTeam = -1;
+        outcome.envitPoints = TrucState::envitValue(pending);
+        n.action[count] = TrucState::ACCEPT;
+        children[count++] = buildTruc(5+raiser*2+(pending==2), outcome, 0, 0, 0);
+        if(pending==1){
+            n.action[count] = TrucState::ENVIT;
+            children[count++] = buildEnvit(1-toAct, 2, 0);
+        }
+    }
+    n.actions = count;
+    for(int a=0;a<count;a++){
+        n.child[a] = children[a];
+    }
+    nodes[id] = n;
+    return id;
+}
+
+// Truc round: P0 may call, then P1, raised up to val quatre. Accepting or
+// two passes go to the showdown.
+int TrucCfr::buildTruc(int envitLeaf, const Node &envit, int toAct, int pending, int passes){
+    int id = nodes.size();
+    nodes.push_back(Node());
+    nodeOf[key(1, envitLeaf, toAct, pending, passes)] = id;
+    Node n = {};
+    n.player = toAct;
+    n.envitFixedTeam = -1;
+    n.trucFixedTeam = -1;
+    int children[MAX_ACTIONS], count = 0;
+    if(pending==0){
+        n.action[count] = PASS;
+        children[count++] = passes==1 ? addTerminal(envit, -1, TrucState::trucValue(0))
+                                      : buildTruc(envitLeaf, envit, 1-toAct, 0, passes+1);
+        n.action[count] = TrucState::TRUC;
+        children[count++] = buildTruc(envitLeaf, envit, 1-toAct, 1, 0);
+    }
+    else{
+        n.action[count] = TrucState::REJECT;
+        children[count++] = addTerminal(envit, 1-toAct, TrucState::trucValue(pending-1));
+        n.action[count] = TrucState::ACCEPT;
+        children[count++] = addTerminal(envit, -1, TrucState::trucValue(pending));
+        if(pending<TrucState::JOC_FORA-1){
+            n.action[count] = TrucState::TRUC;
+            children[count++] = buildTruc(envitLeaf, envit, 1-toAct, pending+1, 0);
+        }
+    }
+    n.actions = count;
+    for(int a=0;a<count;a++){
+        n.child[a] = children[a];
+    }
+    nodes[id] = n;
+    return id;
+}
+
+int TrucCfr::addTerminal(const Node &envit, int trucFixedTeam, int trucPoints){
+    Node n = envit;
+    n.player = -1;
+    n.actions = 0;
+    n.trucFixedTeam = trucFixedTeam;
+    n.trucPoints = trucPoints;
+    nodes.push_back(n);
+    return nodes.size()-1;
+}
+
+//////////////* Abstraction *////
+
+// Bucket of a hand: envit range times truc strength (sum of the card ranks)
+int TrucCfr::bucket(const Card cards[3]){
+    const TrucHandInfo &info = TrucHands::get(cards);
+    int e = info.envit<20 ? 0 : info.envit<26 ? 1 : info.envit<30 ? 2 : info.envit<32 ? 3 : 4;
+    int sum = info.getRank(0)+info.getRank(1)+info.getRank(2);
+    int t = sum<12 ? 0 : sum<16 ? 1 : sum<20 ? 2 : sum<24 ? 3 : sum<28 ? 4 : 5;
+    return e*STRENGTH_BUCKETS+t;
+}
+
+// Envit outcome of the hand so far, numbered like buildEnvit(), -1 for a falta
+int TrucCfr::envitLeafOf(const TrucState &s, int manoTeam){
+    for(int t=0;t<2;t++){
+        if(s.rejectedEnvit[t]>0){
+            int rel = t!=manoTeam;
+            return s.rejectedEnvit[t]>2 ? -1 : 1+rel*2+(s.rejectedEnvit[t]==2);
+        }
+    }
+    if(s.envitLevel==0){
+        return 0;
+    }
+    if(s.envitLevel>2){
+        return -1;
+    }
+    return 5+(s.envitOwner!=manoTeam)*2+(s.envitLevel==2);
+}
+
+// Information set of the seat to move, or -1 when the position is outside
+// the abstraction (tables of 4, later bazas or a card already played, falta,
+// truc called before the envit...)
+int TrucCfr::infosetOf(const TrucState &s) const{
+    if(s.isHandOver() || s.players!=2 || s.baza!=0){
+        return -1;
+    }
+    for(int i=0;i<TrucState::HAND_CARDS;i++){
+        if(s.hasPlayed(s.turn, i)){
+            return -1;
+        }
+    }
+    int manoTeam = s.getTeam(s.mano);
+    int toAct = s.getTeam(s.turn)!=manoTeam;
+    int k = -1;
+    if(s.phase==TrucState::RESPOND){
+        if(s.pending==TrucState::ENVIT){
+            if(s.pendingLevel<=2 && s.trucLevel==0){
+                k = key(0, 0, toAct, s.pendingLevel, 0);
+            }
+        }
+        else if(s.pendingLevel<TrucState::JOC_FORA){
+            int leaf = envitLeafOf(s, manoTeam);
+            k = leaf<0 ? -1 : key(1, leaf, toAct, s.pendingLevel, 0);
+        }
+    }
+    else if(s.trucLevel==0){
+        int leaf = envitLeafOf(s, manoTeam);
+        if(!s.envitClosed){
+            k = key(0, 0, toAct, 0, toAct);
+        }
+        else if(leaf>=0){
+            k = key(1, leaf, toAct, 0, toAct);
+        }
+    }
+    if(k<0 || nodeOf[k]<0){
+        return -1;
+    }
+    return nodeOf[k]*BUCKETS+bucket(s.hands[s.turn]);
+}
+
+//////////////* Strategy *////
+
+// Regret matching on the positive regrets
+void TrucCfr::currentStrategy(int infoset, int actions, float sigma[MAX_ACTIONS]) const{
+    const float *r = &regret[(size_t)infoset*MAX_ACTIONS];
+    float sum = 0.0f;
+    for(int a=0;a<actions;a++){
+        sum += r[a];
+    }
+    for(int a=0;a<actions;a++){
+        sigma[a] = sum>0.0f ? r[a]/sum : 1.0f/actions;
+    }
+}
+
+// Average strategy of an information set, the one that converges
+void TrucCfr::getStrategy(int infoset, float out[MAX_ACTIONS]) const{
+    int actions = nodes[infoset/BUCKETS].actions;
+    const float *s = &strategySum[(size_t)infoset*MAX_ACTIONS];
+    float sum = 0.0f;
+    for(int a=0;a<actions;a++){
+        sum += s[a];
+    }
+    for(int a=0;a<MAX_ACTIONS;a++){
+        out[a] = a>=actions ? 0.0f : sum>0.0f ? s[a]/sum : 1.0f/actions;
+    }
+}
+
+// Action drawn from the average strategy of an information set
+uint8_t TrucCfr::sample(int infoset, Rng &rng) const{
+    const Node &n = nodes[infoset/BUCKETS];
+    float sigma[MAX_ACTIONS];
+    getStrategy(infoset, sigma);
+    float u = (float)rng.uniform();
+    int a = 0;
+    while(a<n.actions-1 && u>=sigma[a]){
+        u -= sigma[a++];
+    }
+    return n.action[a];
+}
+
+// Bid for the seat to move: a TrucState move, or PASS to play a card (also
+// when the position is outside the abstraction). When the envit round
+// passes, the same position is asked again in the truc round.
+uint8_t TrucCfr::decide(const TrucState &s, Rng &rng) const{
+    int infoset = infosetOf(s);
+    if(infoset<0){
+        return PASS;
+    }
+    uint8_t m = sample(infoset, rng);
+    if(m!=PASS || s.phase!=TrucState::PLAY || s.envitClosed){
+        return m;
+    }
+    int manoTeam = s.getTeam(s.mano);
+    int toAct = s.getTeam(s.turn)!=manoTeam;
+    int leaf = envitLeafOf(s, manoTeam);
+    int k = leaf<0 ? -1 : key(1, leaf, toAct, 0, toAct);
+    if(k<0 || nodeOf[k]<0){
+        return PASS;
+    }
+    return sample(nodeOf[k]*BUCKETS+bucket(s.hands[s.turn]), rng);
+}
+
+//////////////* Training *////
+
+// Counterfactual values of the subtree for P0. Adds the regrets (weighted by
+// the opponent's reach) and the strategies (weighted by the own reach) of
+// every information set on the way into the delta buffers.
+float TrucCfr::walk(int node, const int bucket[2], int envitWinner, int trucWinner, float reach0, float reach1,
+                    float *regretDelta, float *strategyDelta) const{
+    const Node &n = nodes[node];
+    if(n.player<0){
+        float u = 0.0f;
+        if(n.envitPoints>0){
+            int team = n.envitFixedTeam>=0 ? n.envitFixedTeam : envitWinner;
+            u += team==0 ? n.envitPoints : -n.envitPoints;
+        }
+        int team = n.trucFixedTeam>=0 ? n.trucFixedTeam : trucWinner;
+        u += team==0 ? n.trucPoints : -n.trucPoints;
+        return u;
+    }
+    int p = n.player;
+    int infoset = node*BUCKETS+bucket[p];
+    float sigma[MAX_ACTIONS], value[MAX_ACTIONS];
+    currentStrategy(infoset, n.actions, sigma);
+    float nodeValue = 0.0f;
+    for(int a=0;a<n.actions;a++){
+        value[a] = p==0 ? walk(n.child[a], bucket, envitWinner, trucWinner, reach0*sigma[a], reach1, regretDelta, strategyDelta)
+                        : walk(n.child[a], bucket, envitWinner, trucWinner, reach0, reach1*sigma[a], regretDelta, strategyDelta);
+        nodeValue += sigma[a]*value[a];
+    }
+    float sign = p==0 ? 1.0f : -1.0f;
+    float opponent = p==0 ? reach1 : reach0;
+    float own = p==0 ? reach0 : reach1;
+    float *r = &regretDelta[(size_t)infoset*MAX_ACTIONS];
+    float *st = &strategyDelta[(size_t)infoset*MAX_ACTIONS];
+    for(int a=0;a<n.actions;a++){
+        r[a] += sign*(value[a]-nodeValue)*opponent;
+        st[a] += own*sigma[a];
+    }
+    return nodeValue;
+}
+
+// Runs `count` more iterations on `threads` workers, `batch` iterations per
+// worker between merges. Iteration i deals from random stream (seed, 0, i).
+void TrucCfr::train(long long count, int threads, uint64_t seed, int batch){
+    threads = threads>0 ? threads : 1;
+    batch = batch>0 ? batch : 1;
+    size_t size = regret.size();
+    std::vector<std::vector<float> > regretDelta(threads, std::vector<float>(size));
+    std::vector<std::vector<float> > strategyDelta(threads, std::vector<float>(size));
+    std::vector<DoubleDummy> solvers(threads);
+    long long end = iterations+count;
+    while(iterations<end){
+        long long first = iterations;
+        long long last = std::min(end, first+(long long)batch*threads);
+        std::vector<std::thread> workers;
+        for(int t=0;t<threads;t++){
+            workers.push_back(std::thread([this, t, threads, first, last, seed, &regretDelta, &strategyDelta, &solvers](){
+                float *rd = regretDelta[t].data();
+                float *sd = strategyDelta[t].data();
+                std::fill(rd, rd+regretDelta[t].size(), 0.0f);
+                std::fill(sd, sd+strategyDelta[t].size(), 0.0f);
+                Deck deck(Deck::SPANISH);
+                deck.seed(seed, 0);
+                TrucState s;
+                s.newGame(2, 24);
+                for(long long i=first+t;i<last;i+=threads){
+                    deck.setHand(i);
+                    s.dealHand(deck, 0);
+                    int bucket[2] = {TrucCfr::bucket(s.hands[0]), TrucCfr::bucket(s.hands[1])};
+                    int envitWinner = s.getTeam(s.getEnvitWinner());
+                    int trucWinner = solvers[t].solve(s, NULL);
+                    walk(0, bucket, envitWinner, trucWinner, 1.0f, 1.0f, rd, sd);
+                }
+            }));
+        }
+        for(std::thread &w: workers){
+            w.join();
+        }
+        // CFR+: regrets floored at zero, strategies averaged with weight = batch
+        batches++;
+        for(size_t i=0;i<size;i++){
+            float r = regret[i], st = 0.0f;
+            for(int t=0;t<threads;t++){
+                r += regretDelta[t][i];
+                st += strategyDelta[t][i];
+            }
+            regret[i] = r>0.0f ? r : 0.0f;
+            strategySum[i] += (float)batches*st;
+        }
+        iterations = last;
+    }
+}
+
+//////////////* Checkpoints *////
+
+bool TrucCfr::save(const std::string &path) const{
+    CfrHeader h;
+    memcpy(h.magic, CFR_MAGIC, sizeof(CFR_MAGIC));
+    h.buckets = BUCKETS;
+    h.nodes = nodes.size();
+    h.actions = MAX_ACTIONS;
+    h.reserved = 0;
+    h.iterations = iterations;
+    h.batches = batches;
+    std::fstream f1;
+    f1.open(path, std::ios::out | std::ios::binary);
+    if(f1.fail()){
+        return false;
+    }
+    f1.write((char*)&h, sizeof(h));
+    f1.write((char*)regret.data(), regret.size()*sizeof(float));
+    f1.write((char*)strategySum.data(), strategySum.size()*sizeof(float));
+    f1.close();
+    return !f1.fail();
+}
+
+// Loads a checkpoint written by save() for the same abstraction
+bool TrucCfr::load(const std::string &path){
+    std::fstream f1;
+    f1.open(path, std::ios::in | std::ios::binary);
+    if(f1.fail()){
+        return false;
+    }
+    CfrHeader h;
+    f1.read((char*)&h, sizeof(h));
+    if(f1.fail() || memcmp(h.magic, CFR_MAGIC, sizeof(CFR_MAGIC))!=0 || h.buckets!=BUCKETS
+       || h.nodes!=(int)nodes.size() || h.actions!=MAX_ACTIONS){
+        return false;
+    }
+    std::vector<float> r(regret.size()), st(strategySum.size());
+    f1.read((char*)r.data(), r.size()*sizeof(float));
+    f1.read((char*)st.data(), st.size()*sizeof(float));
+    if(f1.fail()){
+        return false;
+    }
+    regret.swap(r);
+    strategySum.swap(st);
+    iterations = h.iterations;
+    batches = h.batches;
+    return true;
+}
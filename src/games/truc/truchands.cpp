@@ -0,0 +1,71 @@
+#include "headers/truchands.h"
+
+//////////////* Table Generation *////
+
+// Row of one hand, computed from the card tables
+static constexpr TrucHandInfo describe(Card a, Card b, Card c){
+    Card cards[3] = {a, b, c};
+    TrucHandInfo info{};
+    int envit = 0;
+    for(int i=0;i<3;i++){
+        if(cards[i].getEnvitValue()>envit){
+            envit = cards[i].getEnvitValue();
+        }
+        for(int j=i+1;j<3;j++){
+            if(cards[i].getSuitIndex()==cards[j].getSuitIndex() && 20+cards[i].getEnvitValue()+cards[j].getEnvitValue()>envit){
+                envit = 20+cards[i].getEnvitValue()+cards[j].getEnvitValue();
+            }
+        }
+    }
+    info.envit = envit;
+    info.flor = a.getSuitIndex()==b.getSuitIndex() && b.getSuitIndex()==c.getSuitIndex();
+    int r[3] = {a.getTrucRank(), b.getTrucRank(), c.getTrucRank()};
+    for(int i=0;i<3;i++){
+        for(int j=i+1;j<3;j++){
+            if(r[j]>r[i]){
+                int t = r[i]; r[i] = r[j]; r[j] = t;
+            }
+        }
+    }
+    info.signature = (r[0]<<8)|(r[1]<<4)|r[2];
+    return info;
+}
+
+// Rows in colex order: the largest card varies slowest
+static constexpr std::array<TrucHandInfo, TrucHands::HANDS> generate(){
+    std::array<TrucHandInfo, TrucHands::HANDS> t{};
+    int n = 0;
+    for(int c=2;c<TrucHands::CARDS;c++){
+        for(int b=1;b<c;b++){
+            for(int a=0;a<b;a++){
+                t[n++] = describe(TrucHands::cardAt(a), TrucHands::cardAt(b), TrucHands::cardAt(c));
+            }
+        }
+    }
+    return t;
+}
+
+static constexpr std::array<TrucHandInfo, TrucHands::HANDS> generated = generate();
+static_assert(TrucHands::indexOf(37, 38, 39)==TrucHands::HANDS-1, "colex index must cover the table");
+static_assert(generated[TrucHands::indexOf(5, 6, 16)].envit==33, "6 and 7 of oros with the 7 of espases is 33");
+
+const std::array<TrucHandInfo, TrucHands::HANDS> TrucHands::table = generated;
+
+//////////////* Reverse Lookup *////
+
+// Cards of the hand with colex index `idx`
+void TrucHands::handAt(int idx, Card out[3]){
+    int c = 2;
+    while(choose3(c+1)<=idx){
+        c++;
+    }
+    idx -= choose3(c);
+    int b = 1;
+    while(choose2(b+1)<=idx){
+        b++;
+    }
+    idx -= choose2(b);
+    out[0] = cardAt(idx);
+    out[1] = cardAt(b);
+    out[2] = cardAt(c);
+}
@@ -0,0 +1,364 @@
+#include "headers/trucstate.h"
+#include "headers/truchands.h"
+
+//////////////* Game & Hand Setup *////
+
+// Starts a game for 2 or 4 players, played up to `goal` points
+void TrucState::newGame(int numPlayers, int goal){
+    players = numPlayers==2 ? 2 : 4;
+    target = goal;
+    score[0] = 0;
+    score[1] = 0;
+    phase = HAND_OVER;
+    mano = 0;
+}
+
+// Deals 3 cards to each seat from a full Spanish deck, starting at the mà
+void TrucState::dealHand(Deck &deck, int manoSeat){
+    deck.initializeDeck();
+    for(int i=0;i<HAND_CARDS;i++){
+        for(int j=0;j<players;j++){
+            hands[(manoSeat+j)%players][i] = deck.deal();
+        }
+    }
+    startHand(manoSeat);
+}
+
+// Starts a hand with the cards already in `hands`
+void TrucState::startHand(int manoSeat){
+    for(int j=0;j<MAX_PLAYERS;j++){
+        table[j] = Card();
+    }
+    for(int j=players;j<MAX_PLAYERS;j++){
+        for(int i=0;i<HAND_CARDS;i++){
+            hands[j][i] = Card();
+        }
+    }
+    played = 0;
+    phase = PLAY;
+    mano = manoSeat;
+    turn = manoSeat;
+    leader = manoSeat;
+    baza = 0;
+    inBaza = 0;
+    for(int i=0;i<HAND_CARDS;i++){
+        bazaWinner[i] = -1;
+    }
+    trucLevel = 0;
+    trucOwner = -1;
+    envitLevel = 0;
+    envitOwner = -1;
+    envitClosed = 0;
+    pending = 0;
+    pendingLevel = 0;
+    resumeTurn = manoSeat;
+    handWinner = -1;
+    for(int t=0;t<2;t++){
+        handPoints[t] = 0;
+        rejectedEnvit[t] = 0;
+    }
+}
+
+//////////////* Legal Moves *////
+
+bool TrucState::canCallEnvit() const{
+    if(envitClosed || baza>0){
+        return false;
+    }
+    for(int i=0;i<HAND_CARDS;i++){
+        if(hasPlayed(turn, i)){
+            return false;
+        }
+    }
+    return true;
+}
+
+// Writes the legal moves for `turn` into out, returns how many
+int TrucState::legalMoves(uint8_t out[MOVES]) const{
+    int n = 0;
+    if(phase==RESPOND){
+        out[n++] = ACCEPT;
+        out[n++] = REJECT;
+        if(pending==TRUC && pendingLevel<JOC_FORA){
+            out[n++] = TRUC;
+        }
+        if(pending==ENVIT && pendingLevel==1){
+            out[n++] = ENVIT;
+        }
+        if(pending==ENVIT && pendingLevel<FALTA_ENVIT){
+            out[n++] = FALTA;
+        }
+    }
+    else if(phase==PLAY){
+        for(int i=0;i<HAND_CARDS;i++){
+            if(!hasPlayed(turn, i)){
+                out[n++] = PLAY_FIRST+i;
+            }
+        }
+        if(trucLevel<JOC_FORA && trucOwner!=getTeam(turn)){
+            out[n++] = TRUC;
+        }
+        if(canCallEnvit()){
+            out[n++] = ENVIT;
+            out[n++] = FALTA;
+        }
+    }
+    return n;
+}
+
+bool TrucState::isLegal(uint8_t m) const{
+    uint8_t moves[MOVES];
+    int n = legalMoves(moves);
+    for(int i=0;i<n;i++){
+        if(moves[i]==m){
+            return true;
+        }
+    }
+    return false;
+}
+
+// Simple card play for rollouts: lead with the best card, play the lowest
+// card when the partner is winning the baza, else the lowest card that wins
+// it, else the lowest card. Returns the slot (a PLAY move).
+int TrucState::heuristicCard() const{
+    int bestRank = -1, bestTeam = -1;
+    for(int j=0;j<inBaza;j++){
+        int seat = (leader+j)%players;
+        int rank = table[seat].getTrucRank();
+        if(rank>bestRank){
+            bestRank = rank;
+            bestTeam = getTeam(seat);
+        }
+        else if(rank==bestRank && getTeam(seat)!=bestTeam){
+            bestTeam = PARDA;
+        }
+    }
+    int high = -1, low = -1, beat = -1;
+    for(int i=0;i<HAND_CARDS;i++){
+        if(hasPlayed(turn, i)){
+            continue;
+        }
+        int rank = hands[turn][i].getTrucRank();
+        if(high<0 || rank>hands[turn][high].getTrucRank()) high = i;
+        if(low<0 || rank<hands[turn][low].getTrucRank()) low = i;
+        if(rank>bestRank && (beat<0 || rank<hands[turn][beat].getTrucRank())) beat = i;
+    }
+    if(inBaza==0) return high;
+    if(bestTeam==getTeam(turn)) return low;
+    return beat>=0 ? beat : low;
+}
+
+//////////////* Applying Moves *////
+
+// Applies a legal move of the seat in `turn`
+void TrucState::apply(uint8_t m){
+    if(phase==RESPOND){
+        answer(m);
+        return;
+    }
+    switch(m){
+        case PLAY_FIRST:
+        case PLAY_SECOND:
+        case PLAY_THIRD: playCard(m); return;
+        case TRUC: pending = TRUC;
+                   pendingLevel = trucLevel+1;
+                   break;
+        case ENVIT: pending = ENVIT;
+                    pendingLevel = 1;
+                    break;
+        case FALTA: pending = ENVIT;
+                    pendingLevel = FALTA_ENVIT;
+                    break;
+    }
+    resumeTurn = turn;
+    turn = (turn+1)%players;
+    phase = RESPOND;
+}
+
+// Answer to a pending bid. The raising team is always the one not in `turn`.
+void TrucState::answer(uint8_t m){
+    int raiser = 1-getTeam(turn);
+    if(m==ACCEPT || m==REJECT){
+        if(pending==TRUC){
+            if(m==REJECT){
+                pending = 0;
+                finishHand(raiser);
+                return;
+            }
+            trucLevel = pendingLevel;
+            trucOwner = raiser;
+        }
+        else{
+            if(m==REJECT){
+                rejectedEnvit[raiser] = envitLevel==0 ? 1 : envitValue(envitLevel);
+                envitLevel = 0;
+            }
+            else{
+                envitLevel = pendingLevel;
+                envitOwner = raiser;
+            }
+            envitClosed = 1;
+        }
+        pending = 0;
+        phase = PLAY;
+        turn = resumeTurn;
+        return;
+    }
+    // Raising accepts the pending level and passes the answer to the other team
+    if(pending==TRUC){
+        trucLevel = pendingLevel;
+        trucOwner = raiser;
+        pendingLevel++;
+    }
+    else{
+        envitLevel = pendingLevel;
+        envitOwner = raiser;
+        pendingLevel = m==ENVIT ? 2 : FALTA_ENVIT;
+    }
+    turn = (turn+1)%players;
+}
+
+void TrucState::playCard(int i){
+    table[turn] = hands[turn][i];
+    played |= 1<<(turn*HAND_CARDS+i);
+    inBaza++;
+    if(inBaza==players){
+        endBaza();
+    }
+    else{
+        turn = (turn+1)%players;
+    }
+}
+
+// Settles a full baza and moves on to the next one (or ends the hand)
+void TrucState::endBaza(){
+    int best = leader;
+    int8_t result = getTeam(leader);
+    for(int j=1;j<players;j++){
+        int seat = (leader+j)%players;
+        int rank = table[seat].getTrucRank();
+        int top = table[best].getTrucRank();
+        if(rank>top){
+            best = seat;
+            result = getTeam(seat);
+        }
+        else if(rank==top && getTeam(seat)!=getTeam(best)){
+            result = PARDA;
+        }
+    }
+    bazaWinner[baza] = result;
+    baza++;
+    inBaza = 0;
+    envitClosed = 1;
+    if(result!=PARDA){
+        leader = best;
+    }
+    for(int j=0;j<MAX_PLAYERS;j++){
+        table[j] = Card();
+    }
+    int winner = decideHand();
+    if(winner>=0){
+        finishHand(winner);
+    }
+    else{
+        turn = leader;
+    }
+}
+
+// Team that has won the hand with the bazas played so far (-1 if undecided)
+int TrucState::decideHand() const{
+    int wins[2] = {0, 0};
+    for(int b=0;b<baza;b++){
+        if(bazaWinner[b]!=PARDA){
+            wins[bazaWinner[b]]++;
+        }
+    }
+    for(int t=0;t<2;t++){
+        if(wins[t]>=2){
+            return t;
+        }
+    }
+    if(baza>=2){
+        if(bazaWinner[0]==PARDA && bazaWinner[1]!=PARDA){
+            return bazaWinner[1];
+        }
+        if(bazaWinner[0]!=PARDA && bazaWinner[1]==PARDA){
+            return bazaWinner[0];
+        }
+    }
+    if(baza==3){
+        if(bazaWinner[2]!=PARDA){
+            return bazaWinner[2];
+        }
+        return bazaWinner[0]!=PARDA ? bazaWinner[0] : getTeam(mano);
+    }
+    return -1;
+}
+
+// Scores the hand: envits first, then the truc
+void TrucState::finishHand(int team){
+    handWinner = team;
+    int points[2] = {rejectedEnvit[0], rejectedEnvit[1]};
+    if(envitLevel>0){
+        points[getEnvitWinner()] += envitLevel==FALTA_ENVIT ? getFalta() : envitValue(envitLevel);
+    }
+    for(int t=0;t<2;t++){
+        handPoints[t] = points[t];
+        score[t] = score[t]+points[t]>=target ? target : score[t]+points[t];
+    }
+    if(getGameWinner()<0){
+        int truc = trucLevel==JOC_FORA ? target-score[team] : trucValue(trucLevel);
+        handPoints[team] += truc;
+        score[team] = score[team]+truc>=target ? target : score[team]+truc;
+    }
+    phase = getGameWinner()>=0 ? GAME_OVER : HAND_OVER;
+}
+
+//////////////* Scoring Helpers *////
+
+int TrucState::getGameWinner() const{
+    if(score[0]>=target) return 0;
+    if(score[1]>=target) return 1;
+    return -1;
+}
+
+// Team with the best envit, ties go to the seat nearest the mà
+int TrucState::getEnvitWinner() const{
+    int best = mano;
+    int value = envitOf(hands[mano]);
+    for(int j=1;j<players;j++){
+        int seat = (mano+j)%players;
+        int e = envitOf(hands[seat]);
+        if(e>value){
+            best = seat;
+            value = e;
+        }
+    }
+    return getTeam(best);
+}
+
+// Falta envit: what the leading team lacks to win the game
+int TrucState::getFalta() const{
+    int lead = score[0]>score[1] ? score[0] : score[1];
+    return target>lead ? target-lead : 1;
+}
+
+// Envit of three cards: 20 plus the two best of a suit, else the best card
+int TrucState::envitOf(const Card cards[HAND_CARDS]){
+    return TrucHands::get(cards).envit;
+}
+
+// Points of an accepted truc level (below joc fora)
+int TrucState::trucValue(int level){
+    return level+1;
+}
+
+// Points of an accepted envit level (below falta)
+int TrucState::envitValue(int level){
+    return level==1 ? 2 : 4;
+}
+
+const char* TrucState::moveName(uint8_t m){
+    static const char *names[MOVES] = {"Card 1", "Card 2", "Card 3", "Truc", "Envit", "Falta", "Vull", "No vull"};
+    return m<MOVES ? names[m] : "?";
+}
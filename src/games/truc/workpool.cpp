@@ -0,0 +1,48 @@
+#include "headers/workpool.h"
+#include <thread>
+
+WorkPool::WorkPool(int t): threads(t>0 ? t : 1), queues(threads), steals(0) {}
+
+// Own jobs first (newest first), then the oldest job of the next busy worker
+bool WorkPool::take(int worker, int &job){
+    {
+        Queue &q = queues[worker];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(!q.jobs.empty()){
+            job = q.jobs.back();
+            q.jobs.pop_back();
+            return true;
+        }
+    }
+    for(int i=1;i<threads;i++){
+        Queue &q = queues[(worker+i)%threads];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if(!q.jobs.empty()){
+            job = q.jobs.front();
+            q.jobs.pop_front();
+            steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Runs work(worker, job) for every job and returns when all are done. No
+// job is added while running, so a worker finding every deque empty is done.
+void WorkPool::run(const std::vector<int> &jobs, const std::function<void(int worker, int job)> &work){
+    for(size_t i=0;i<jobs.size();i++){
+        queues[i%threads].jobs.push_back(jobs[i]);
+    }
+    std::vector<std::thread> pool;
+    for(int w=0;w<threads;w++){
+        pool.emplace_back([this, w, &work](){
+            int job;
+            while(take(w, job)){
+                work(w, job);
+            }
+        });
+    }
+    for(std::thread &t: pool){
+        t.join();
+    }
+}